@@ -9,6 +9,94 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    struct EnvelopeParameterIDs
+    {
+        juce::String attack, decay, sustain, release, rate;
+    };
+    
+    struct LfoParameterIDs
+    {
+        juce::String shape, rate;
+    };
+    
+    struct RouteParameterIDs
+    {
+        juce::String source, destination, depth, rate;
+    };
+    
+    struct ParameterIDs
+    {
+        EnvelopeParameterIDs envelope, modEnvelope;
+        std::array<LfoParameterIDs, (size_t) VoiceBank::numLfos> lfos;
+        std::array<RouteParameterIDs, (size_t) ModMatrix::numSlots> routes;
+    };
+    
+    /** IDs of the envelope, LFO and route parameters: "Attack", "Mod Attack",
+        "LFO1 Rate", "Route3 Depth" and so on. Built once, the first time the
+        parameter layout is created, so reading the parameters on the audio
+        thread never builds a string.
+    */
+    const ParameterIDs& getParameterIDs()
+    {
+        static const auto ids = []
+        {
+            ParameterIDs result;
+            
+            auto makeEnvelopeIDs = [] (const juce::String& prefix) -> EnvelopeParameterIDs
+            {
+                return { prefix + "Attack", prefix + "Decay", prefix + "Sustain", prefix + "Release", prefix + "Envelope Rate" };
+            };
+            
+            result.envelope = makeEnvelopeIDs("");
+            result.modEnvelope = makeEnvelopeIDs("Mod ");
+            
+            for (size_t i = 0; i < result.lfos.size(); ++i)
+            {
+                auto prefix = "LFO" + juce::String((int) i + 1) + " ";
+                result.lfos[i] = { prefix + "Shape", prefix + "Rate" };
+            }
+            
+            for (size_t i = 0; i < result.routes.size(); ++i)
+            {
+                auto prefix = "Route" + juce::String((int) i + 1) + " ";
+                result.routes[i] = { prefix + "Source", prefix + "Destination", prefix + "Depth", prefix + "Rate" };
+            }
+            
+            return result;
+        }();
+        
+        return ids;
+    }
+    
+    EnvelopeBank::Parameters getEnvelopeParameters (juce::AudioProcessorValueTreeState& apvts, const EnvelopeParameterIDs& ids)
+    {
+        EnvelopeBank::Parameters parameters;
+        parameters.attackSeconds = apvts.getRawParameterValue(ids.attack)->load();
+        parameters.decaySeconds = apvts.getRawParameterValue(ids.decay)->load();
+        parameters.sustainLevel = apvts.getRawParameterValue(ids.sustain)->load();
+        parameters.releaseSeconds = apvts.getRawParameterValue(ids.release)->load();
+        parameters.rate = static_cast<EnvelopeBank::Rate>(static_cast<int>(apvts.getRawParameterValue(ids.rate)->load()));
+        return parameters;
+    }
+    
+    void addEnvelopeParameters (juce::AudioProcessorValueTreeState::ParameterLayout& layout, const EnvelopeParameterIDs& ids)
+    {
+        EnvelopeBank::Parameters defaults;
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids.attack, ids.attack, juce::NormalisableRange<float>(0.001f, 5.f, 0.001f, 0.3f), defaults.attackSeconds));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids.decay, ids.decay, juce::NormalisableRange<float>(0.001f, 5.f, 0.001f, 0.3f), defaults.decaySeconds));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids.sustain, ids.sustain, juce::NormalisableRange<float>(0.f, 1.f, 0.01f, 1.f), defaults.sustainLevel));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids.release, ids.release, juce::NormalisableRange<float>(0.001f, 10.f, 0.001f, 0.3f), defaults.releaseSeconds));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(ids.rate, ids.rate, juce::StringArray { "Audio", "Control" }, (int) defaults.rate));
+    }
+}
+
 //==============================================================================
 BasicOSSAudioProcessor::BasicOSSAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -23,11 +111,17 @@ BasicOSSAudioProcessor::BasicOSSAudioProcessor()
 #endif
 {
     synth.addSound(new SynthSound());
-    synth.addVoice(new SynthVoice());
+    
+    for (auto* param : getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            apvts.addParameterListener (paramWithID->paramID, this);
 }
 
 BasicOSSAudioProcessor::~BasicOSSAudioProcessor()
 {
+    for (auto* param : getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            apvts.removeParameterListener (paramWithID->paramID, this);
 }
 
 //==============================================================================
@@ -95,7 +189,7 @@ void BasicOSSAudioProcessor::changeProgramName (int index, const juce::String& n
 //==============================================================================
 void BasicOSSAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    synth.setCurrentPlaybackSampleRate(sampleRate);
+    synth.prepare(sampleRate, samplesPerBlock);
 }
 
 void BasicOSSAudioProcessor::releaseResources()
@@ -140,13 +234,8 @@ void BasicOSSAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    for (int i = 0; i <synth.getNumVoices(); ++i){
-        if (auto voice = dynamic_cast < juce::SynthesiserVoice*>(synth.getVoice(i))){
-//            Osc control
-//            ADSR
-//            LOF
-        }
-    }
+    if (parametersChanged.exchange (false))
+        updateVoiceBank();
     
     synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
@@ -165,15 +254,112 @@ juce::AudioProcessorEditor* BasicOSSAudioProcessor::createEditor()
 //==============================================================================
 void BasicOSSAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    if (auto xml = apvts.copyState().createXml())
+        copyXmlToBinary(*xml, destData);
 }
 
 void BasicOSSAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    if (auto xml = getXmlFromBinary(data, sizeInBytes))
+        if (xml->hasTagName(apvts.state.getType()))
+            apvts.replaceState(juce::ValueTree::fromXml(*xml));
+}
+
+void BasicOSSAudioProcessor::parameterChanged (const juce::String&, float)
+{
+    parametersChanged = true;
+}
+
+void BasicOSSAudioProcessor::updateVoiceBank()
+{
+    auto& ids = getParameterIDs();
+    
+    VoiceBank::Settings settings;
+    settings.shape = static_cast<WavetableSet::Shape>(static_cast<int>(apvts.getRawParameterValue("Shape")->load()));
+    settings.oscillator = static_cast<VoiceBank::Oscillator>(static_cast<int>(apvts.getRawParameterValue("Oscillator")->load()));
+    settings.pulseWidth = apvts.getRawParameterValue("Pulse Width")->load();
+    settings.syncRatio = apvts.getRawParameterValue("Sync Ratio")->load();
+    settings.envelope = getEnvelopeParameters(apvts, ids.envelope);
+    settings.modEnvelope = getEnvelopeParameters(apvts, ids.modEnvelope);
+    
+    for (int i = 0; i < VoiceBank::numLfos; ++i)
+    {
+        auto& lfo = settings.lfos[(size_t) i];
+        auto& lfoIDs = ids.lfos[(size_t) i];
+        lfo.shape = static_cast<ModMatrix::LfoShape>(static_cast<int>(apvts.getRawParameterValue(lfoIDs.shape)->load()));
+        lfo.rateHz = apvts.getRawParameterValue(lfoIDs.rate)->load();
+    }
+    
+    settings.cutoffHz = apvts.getRawParameterValue("Cutoff")->load();
+    settings.resonance = apvts.getRawParameterValue("Resonance")->load();
+    settings.level = apvts.getRawParameterValue("Level")->load();
+    
+    ModMatrix::Routes routes;
+    
+    for (int slot = 0; slot < ModMatrix::numSlots; ++slot)
+    {
+        auto& route = routes[(size_t) slot];
+        auto& routeIDs = ids.routes[(size_t) slot];
+        route.source = static_cast<ModMatrix::Source>(static_cast<int>(apvts.getRawParameterValue(routeIDs.source)->load()));
+        route.destination = static_cast<ModMatrix::Destination>(static_cast<int>(apvts.getRawParameterValue(routeIDs.destination)->load()));
+        route.depth = apvts.getRawParameterValue(routeIDs.depth)->load();
+        route.rate = static_cast<ModMatrix::Rate>(static_cast<int>(apvts.getRawParameterValue(routeIDs.rate)->load()));
+    }
+    
+    synth.setSettings(settings);
+    synth.setRoutes(routes);
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout BasicOSSAudioProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+    VoiceBank::Settings defaults;
+    auto& ids = getParameterIDs();
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>("Shape", "Shape", juce::StringArray { "Sine", "Saw", "Square", "Triangle" }, (int) defaults.shape));
+    
+    // The pulse width and sync only apply to the analytic oscillator, and a Sine
+    // always comes from its table.
+    layout.add(std::make_unique<juce::AudioParameterChoice>("Oscillator", "Oscillator", juce::StringArray { "Wavetable", "Analytic" }, (int) defaults.oscillator));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Pulse Width", "Pulse Width", juce::NormalisableRange<float>(0.05f, 0.95f, 0.01f, 1.f), defaults.pulseWidth));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Sync Ratio", "Sync Ratio", juce::NormalisableRange<float>(1.f, 8.f, 0.01f, 0.5f), defaults.syncRatio));
+    
+    addEnvelopeParameters(layout, ids.envelope);
+    addEnvelopeParameters(layout, ids.modEnvelope);
+    
+    for (int i = 0; i < VoiceBank::numLfos; ++i)
+    {
+        auto& lfoIDs = ids.lfos[(size_t) i];
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(lfoIDs.shape, lfoIDs.shape, juce::StringArray { "Sine", "Triangle", "Saw", "Square" }, 0));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(lfoIDs.rate, lfoIDs.rate, juce::NormalisableRange<float>(0.01f, 50.f, 0.01f, 0.3f), 5.f));
+    }
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Cutoff", "Cutoff", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), defaults.cutoffHz));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Resonance", "Resonance", juce::NormalisableRange<float>(0.1f, 10.f, 0.01f, 0.3f), defaults.resonance));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>("Level", "Level", juce::NormalisableRange<float>(0.f, 1.f, 0.01f, 1.f), defaults.level));
+    
+    // Depths are in semitones for Pitch, octaves for Cutoff, and full scale for
+    // Amplitude and Pulse Width, as in ModMatrix.
+    for (int slot = 0; slot < ModMatrix::numSlots; ++slot)
+    {
+        auto& routeIDs = ids.routes[(size_t) slot];
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(routeIDs.source, routeIDs.source, juce::StringArray { "None", "LFO 1", "LFO 2", "Envelope", "Mod Envelope" }, 0));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(routeIDs.destination, routeIDs.destination, juce::StringArray { "Pitch", "Cutoff", "Amplitude", "Pulse Width" }, 0));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(routeIDs.depth, routeIDs.depth, juce::NormalisableRange<float>(-24.f, 24.f, 0.01f, 1.f), 0.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(routeIDs.rate, routeIDs.rate, juce::StringArray { "Control", "Audio" }, 0));
+    }
+    
+    return layout;
 }
 
 //==============================================================================
@@ -182,5 +368,3 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new BasicOSSAudioProcessor();
 }
-
-//value tree
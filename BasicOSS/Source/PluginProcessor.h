@@ -15,7 +15,8 @@
 //==============================================================================
 /**
 */
-class BasicOSSAudioProcessor  : public juce::AudioProcessor
+class BasicOSSAudioProcessor  : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -57,10 +58,24 @@ public:
     //==============================================================================
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameterLayout()};
 
 private:
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
     
-    juce::Synthesiser synth;
+    /** Builds the voice bank's settings and routes from the parameters and hands
+        them to the synth. Called on the audio thread, before rendering, only when
+        a parameter has changed since the last block, so automation lands on the
+        block it belongs to. Nothing here allocates.
+    */
+    void updateVoiceBank();
+    
+    BankSynthesiser synth;
+    
+    // Set by the APVTS listener on whichever thread changed a parameter, and
+    // consumed at the top of processBlock.
+    std::atomic<bool> parametersChanged { true };
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicOSSAudioProcessor)
 };
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    envelopebank.cpp
+    Created: 18 Oct 2026 3:02:51pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "envelopebank.h"
+
+namespace
+{
+    // How far past its end each curve aims: the attack's is gentle, so that it
+    // sounds like a charge, while decays and releases fall off like a real one.
+    constexpr double attackOvershoot = 0.3;
+    constexpr double fallOvershoot = 0.001;
+}
+
+EnvelopeBank::EnvelopeBank()
+{
+    stage.fill (idle);
+    updateSegments();
+}
+
+void EnvelopeBank::prepare (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    updateSegments();
+
+    for (int voice = 0; voice < maxVoices; ++voice)
+        reset (voice);
+
+    finishedVoices = 0;
+}
+
+void EnvelopeBank::setParameters (const Parameters& newParameters)
+{
+    parameters = newParameters;
+    updateSegments();
+}
+
+void EnvelopeBank::noteOn (int voice)
+{
+    stage[(size_t) voice] = attack;
+}
+
+void EnvelopeBank::noteOff (int voice)
+{
+    if (stage[(size_t) voice] != idle)
+        stage[(size_t) voice] = release;
+}
+
+void EnvelopeBank::reset (int voice)
+{
+    level[(size_t) voice] = 0.f;
+    stage[(size_t) voice] = idle;
+    finishedVoices &= ~(std::uint64_t (1) << voice);
+}
+
+std::uint64_t EnvelopeBank::takeFinishedVoices() noexcept
+{
+    auto finished = finishedVoices;
+    finishedVoices = 0;
+    return finished;
+}
+
+void EnvelopeBank::process (int firstVoice, Vec* output, int numSamples)
+{
+    auto first = (size_t) firstVoice;
+    auto step = parameters.rate == Rate::Control ? controlPeriod : 1;
+
+    auto current = Vec::fromRawArray (level.data() + first);
+    Vec coefficient, base, floor, isAttacking;
+    bool anyAttacking = false;
+    Vec decayCoefficient, decayBase;
+
+    const Vec half (0.5f), one (1.f);
+    const Vec sustain (segments[decay].floor);
+
+    // Each lane's segment, for steps of length samples.
+    auto loadSegments = [&] (int length)
+    {
+        for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+        {
+            auto& segment = segments[stage[first + lane]];
+            coefficient.set (lane, segment.coefficient[(size_t) length]);
+            base.set (lane, segment.base[(size_t) length]);
+            floor.set (lane, segment.floor);
+            isAttacking.set (lane, stage[first + lane] == attack ? 1.f : 0.f);
+        }
+
+        anyAttacking = isAttacking.sum() > 0.f;
+
+        decayCoefficient = Vec (segments[decay].coefficient[(size_t) length]);
+        decayBase = Vec (segments[decay].base[(size_t) length]);
+    };
+
+    // Attacks that got to the top carry on into their decay.
+    auto updateStages = [&]
+    {
+        for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+            if (stage[first + lane] == attack && isAttacking.get (lane) < 0.5f)
+                stage[first + lane] = decay;
+    };
+
+    auto stepCurve = [&]
+    {
+        current = Vec::min (one, Vec::max (floor, current * coefficient + base));
+
+        if (! anyAttacking)
+            return;
+
+        auto isAtTop = Vec::greaterThanOrEqual (current, one) & Vec::greaterThan (isAttacking, half);
+        coefficient += (decayCoefficient - coefficient) & isAtTop;
+        base += (decayBase - base) & isAtTop;
+        floor += (sustain - floor) & isAtTop;
+        isAttacking = isAttacking - (isAttacking & isAtTop);
+        anyAttacking = isAttacking.sum() > 0.f;
+    };
+
+    loadSegments (step);
+
+    if (step == 1)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            stepCurve();
+            output[i] = current;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; i += step)
+        {
+            auto length = juce::jmin (step, numSamples - i);
+
+            // A short last step needs the curve for its own length.
+            if (length != step)
+            {
+                updateStages();
+                loadSegments (length);
+            }
+
+            auto start = current;
+            stepCurve();
+
+            auto increment = (current - start) * Vec (1.f / (float) length);
+            auto ramp = start;
+
+            for (int j = 0; j < length - 1; ++j)
+            {
+                ramp += increment;
+                output[i + j] = ramp;
+            }
+
+            output[i + length - 1] = current;
+        }
+    }
+
+    updateStages();
+    current.copyToRawArray (level.data() + first);
+
+    for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+    {
+        if (stage[first + lane] == release && level[first + lane] <= 0.f)
+        {
+            stage[first + lane] = idle;
+            finishedVoices |= std::uint64_t (1) << (first + lane);
+        }
+    }
+}
+
+void EnvelopeBank::updateSegments()
+{
+    auto sustainLevel = juce::jlimit (0.0, 1.0, (double) parameters.sustainLevel);
+
+    segments[attack] = makeSegment (parameters.attackSeconds, 1.0 + attackOvershoot, attackOvershoot, 0.f);
+    segments[decay] = makeSegment (parameters.decaySeconds, sustainLevel - fallOvershoot, fallOvershoot, (float) sustainLevel);
+    segments[release] = makeSegment (parameters.releaseSeconds, -fallOvershoot, fallOvershoot, 0.f);
+
+    // Idle voices sit at zero.
+    segments[idle] = {};
+}
+
+/** A curve heading for target that covers a full-scale segment in the given
+    time, when it aims overshoot past its end.
+*/
+EnvelopeBank::Segment EnvelopeBank::makeSegment (double seconds, double target, double overshoot, float floor) const
+{
+    auto numSamples = juce::jmax (1.0, seconds * sampleRate);
+    auto coefficient = std::exp (-std::log ((1.0 + overshoot) / overshoot) / numSamples);
+
+    Segment segment;
+    segment.floor = floor;
+
+    for (size_t length = 0; length < segment.coefficient.size(); ++length)
+    {
+        auto power = std::pow (coefficient, (double) length);
+        segment.coefficient[length] = (float) power;
+        segment.base[length] = (float) (target * (1.0 - power));
+    }
+
+    return segment;
+}
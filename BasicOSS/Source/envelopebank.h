@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    envelopebank.h
+    Created: 18 Oct 2026 3:02:51pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Exponential ADSR envelopes for a bank of voices, worked out a SIMD
+    register's worth of voices at a time.
+
+    Each segment is a one-pole curve, level = level * coefficient + base,
+    aimed a little past where it ends so that it gets there in its set time.
+    The coefficients for every segment are worked out when the parameters
+    change, for one step of one sample and for steps of up to a control
+    period, so running an envelope never calls anything but a multiply-add.
+
+    At control rate the curve is only stepped once a control period and the
+    output ramps linearly in between, and segments can only change on those
+    steps. Voices whose release has run out are gathered into a mask as they
+    go, so the owner learns which voices to free without asking each one.
+*/
+class EnvelopeBank
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxVoices = 64;
+    static constexpr int voicesPerPass = (int) Vec::size();
+    static constexpr int controlPeriod = 32;
+
+    enum class Rate
+    {
+        Audio,
+        Control
+    };
+
+    struct Parameters
+    {
+        float attackSeconds = 0.005f;
+        float decaySeconds = 0.2f;
+        float sustainLevel = 0.7f;
+        float releaseSeconds = 0.3f;
+        Rate rate = Rate::Audio;
+    };
+
+    EnvelopeBank();
+
+    void prepare (double sampleRate);
+    void setParameters (const Parameters&);
+
+    void noteOn (int voice);
+    void noteOff (int voice);
+    void reset (int voice);
+
+    /** Runs the voices from firstVoice to firstVoice + voicesPerPass, writing
+        numSamples of their levels to output, a lane per voice.
+    */
+    void process (int firstVoice, Vec* output, int numSamples);
+
+    /** Returns the voices whose release has run out since the last call, which
+        are idle from then on, and forgets them.
+    */
+    std::uint64_t takeFinishedVoices() noexcept;
+
+private:
+    enum Stage
+    {
+        attack,
+        decay,
+        release,
+        idle,
+        numStages
+    };
+
+    /** A segment's curve over steps of 1 to controlPeriod samples. */
+    struct Segment
+    {
+        std::array<float, controlPeriod + 1> coefficient {}, base {};
+        float floor = 0.f;
+    };
+
+    void updateSegments();
+    Segment makeSegment (double seconds, double target, double overshoot, float floor) const;
+
+    alignas (Vec::SIMDRegisterSize) std::array<float, (size_t) maxVoices> level {};
+    std::array<Stage, (size_t) maxVoices> stage {};
+
+    std::array<Segment, numStages> segments;
+    Parameters parameters;
+    double sampleRate = 44100.0;
+
+    std::uint64_t finishedVoices = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EnvelopeBank)
+};
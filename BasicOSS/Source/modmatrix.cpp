@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    modmatrix.cpp
+    Created: 18 Oct 2026 4:26:09pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "modmatrix.h"
+
+ModMatrix::ModMatrix()
+{
+    controlConnections.reserve ((size_t) numSlots);
+    audioConnections.reserve ((size_t) numSlots);
+}
+
+void ModMatrix::setRoutes (const Routes& newRoutes)
+{
+    routes = newRoutes;
+    compile();
+}
+
+void ModMatrix::compile()
+{
+    controlConnections.clear();
+    audioConnections.clear();
+    controlSources = audioSources = 0;
+    controlDestinations = audioDestinations = 0;
+    std::fill (audioDepth.begin(), audioDepth.end(), 0.f);
+
+    for (auto& route : routes)
+    {
+        if (route.source == Source::None || route.depth == 0.f)
+            continue;
+
+        auto isAudio = route.rate == Rate::Audio && route.destination != Destination::Cutoff;
+        auto& connections = isAudio ? audioConnections : controlConnections;
+
+        auto source = (int) route.source;
+        auto destination = (int) route.destination;
+
+        auto existing = std::find_if (connections.begin(), connections.end(), [=] (const Connection& c)
+        {
+            return c.source == source && c.destination == destination;
+        });
+
+        if (existing != connections.end())
+            existing->depth += route.depth;
+        else
+            connections.push_back ({ source, destination, route.depth });
+    }
+
+    // Routes that cancelled each other out are gone too.
+    for (auto* connections : { &controlConnections, &audioConnections })
+        connections->erase (std::remove_if (connections->begin(), connections->end(),
+                                            [] (const Connection& c) { return c.depth == 0.f; }),
+                            connections->end());
+
+    for (auto& c : controlConnections)
+    {
+        controlSources |= 1u << c.source;
+        controlDestinations |= 1u << c.destination;
+    }
+
+    for (auto& c : audioConnections)
+    {
+        audioSources |= 1u << c.source;
+        audioDestinations |= 1u << c.destination;
+        audioDepth[(size_t) c.destination] += std::abs (c.depth);
+    }
+}
@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    modmatrix.h
+    Created: 18 Oct 2026 4:26:09pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    The routings from the voices' modulation sources to what they modulate.
+
+    The matrix has a fixed number of slots, but the voices never look at them:
+    whenever the routes change they are compiled into two flat lists of
+    connections, one worked out once a control period and ramped, the other
+    every sample. Empty slots and zero depths don't make it into either list,
+    and routes with the same source, destination and rate are merged, so a
+    voice only ever does the work of the routes that are actually there.
+
+    LFOs swing from -1 to 1 and envelopes from 0 to 1. Depths are in semitones
+    for Pitch, octaves for Cutoff, and full scale for Amplitude, which scales
+    by 1 plus the modulation, and for PulseWidth, which is added to.
+*/
+class ModMatrix
+{
+public:
+    enum class Source
+    {
+        None,
+        Lfo1,
+        Lfo2,
+        Envelope,
+        ModEnvelope
+    };
+
+    enum class Destination
+    {
+        Pitch,
+        Cutoff,
+        Amplitude,
+        PulseWidth
+    };
+
+    enum class Rate
+    {
+        Control,
+        Audio       // Cutoff is always modulated at control rate
+    };
+
+    enum class LfoShape
+    {
+        Sine,
+        Triangle,
+        Saw,
+        Square
+    };
+
+    static constexpr int numSources = 5;
+    static constexpr int numDestinations = 4;
+    static constexpr int numSlots = 8;
+
+    struct Route
+    {
+        Source source = Source::None;
+        Destination destination = Destination::Pitch;
+        float depth = 0.f;
+        Rate rate = Rate::Control;
+    };
+
+    using Routes = std::array<Route, (size_t) numSlots>;
+
+    /** One compiled route: adds depth times source to destination. */
+    struct Connection
+    {
+        int source;
+        int destination;
+        float depth;
+    };
+
+    ModMatrix();
+
+    void setRoutes (const Routes&);
+    const Routes& getRoutes() const noexcept                            { return routes; }
+
+    const std::vector<Connection>& getControlConnections() const noexcept   { return controlConnections; }
+    const std::vector<Connection>& getAudioConnections() const noexcept     { return audioConnections; }
+
+    bool usesSource (Source source) const noexcept              { return ((controlSources | audioSources) >> (int) source) & 1; }
+    bool usesControlSource (Source source) const noexcept       { return (controlSources >> (int) source) & 1; }
+    bool usesAudioSource (Source source) const noexcept         { return (audioSources >> (int) source) & 1; }
+
+    bool isControlled (Destination d) const noexcept            { return (controlDestinations >> (int) d) & 1; }
+    bool isAudioModulated (Destination d) const noexcept        { return (audioDestinations >> (int) d) & 1; }
+    bool isModulated (Destination d) const noexcept             { return isControlled (d) || isAudioModulated (d); }
+
+    /** The most the audio rate routes can move the destination by, either way. */
+    float getAudioDepth (Destination d) const noexcept          { return audioDepth[(size_t) d]; }
+
+    /** Adds each connection's source, times its depth, into its destination. */
+    template <typename Vec>
+    static void apply (const std::vector<Connection>& connections, const Vec* sources, Vec* destinations) noexcept
+    {
+        for (auto& connection : connections)
+            destinations[connection.destination] += sources[connection.source] * Vec (connection.depth);
+    }
+
+    /** The LFO's value at phase, from 0 to 1, for each lane. The sine is a
+        parabola refined to within a thousandth of a true one.
+    */
+    template <typename Vec>
+    static Vec getLfoValue (LfoShape shape, Vec phase) noexcept
+    {
+        const Vec one (1.f), two (2.f);
+
+        switch (shape)
+        {
+            case LfoShape::Sine:
+            {
+                auto x = phase * two - one;
+                auto s = Vec (4.f) * x * (one - Vec::abs (x));
+                return Vec (0.f) - (s + Vec (0.225f) * (s * Vec::abs (s) - s));
+            }
+
+            case LfoShape::Triangle:
+            {
+                auto q = phase + Vec (0.25f) - (one & Vec::greaterThanOrEqual (phase, Vec (0.75f)));
+                return one - Vec (4.f) * Vec::abs (q - Vec (0.5f));
+            }
+
+            case LfoShape::Saw:     return phase * two - one;
+            case LfoShape::Square:  return one - (two & Vec::greaterThanOrEqual (phase, Vec (0.5f)));
+        }
+
+        return {};
+    }
+
+private:
+    void compile();
+
+    Routes routes;
+
+    std::vector<Connection> controlConnections, audioConnections;
+    std::uint32_t controlSources = 0, audioSources = 0;
+    std::uint32_t controlDestinations = 0, audioDestinations = 0;
+    std::array<float, (size_t) numDestinations> audioDepth {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModMatrix)
+};
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    polyblep.h
+    Created: 18 Oct 2026 1:37:22pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Two-sample polyBLEP and polyBLAMP corrections for a SIMD register's worth of
+    oscillators at once.
+
+    The oscillator runs one sample behind, so that a discontinuity found while
+    working out a sample can still be smoothed into the sample before it. Each
+    event gives how long ago it happened, from 0 to 1 samples, and only the
+    lanes in its mask are corrected, so no lane ever branches.
+*/
+template <typename Vec>
+struct PolyBlep
+{
+    using Mask = typename Vec::vMaskType;
+
+    /** Added to the sample before the events, and to the one after. */
+    Vec previous { 0.f }, current { 0.f };
+
+    /** A jump in value by height. */
+    void addStep (Mask mask, Vec timeSince, Vec height) noexcept
+    {
+        auto timeAfter = Vec (1.f) - timeSince;
+        auto halfHeight = height * Vec (0.5f);
+
+        previous += (halfHeight * timeSince * timeSince) & mask;
+        current -= (halfHeight * timeAfter * timeAfter) & mask;
+    }
+
+    /** A jump in slope by slopeChange per sample. */
+    void addRamp (Mask mask, Vec timeSince, Vec slopeChange) noexcept
+    {
+        auto timeAfter = Vec (1.f) - timeSince;
+        auto sixthChange = slopeChange * Vec (1.f / 6.f);
+
+        previous += (sixthChange * timeSince * timeSince * timeSince) & mask;
+        current += (sixthChange * timeAfter * timeAfter * timeAfter) & mask;
+    }
+};
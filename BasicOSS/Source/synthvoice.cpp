@@ -10,25 +10,73 @@
 
 #include "synthvoice.h"
 
+SynthVoice::SynthVoice (VoiceBank& b, int s)
+    : bank (b), slot (s) {
+}
+
 bool SynthVoice::canPlaySound (juce::SynthesiserSound *sound) {
-    return dynamic_cast<juce::SynthesiserSound*>(sound) != nullptr;
+    return dynamic_cast<SynthSound*>(sound) != nullptr;
 }
 
 void SynthVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition) {
-    
+    pitchWheelPosition = currentPitchWheelPosition;
+    bank.startVoice (slot, getFrequency (midiNoteNumber), velocity);
 }
 
 void SynthVoice::stopNote (float velocity, bool allowTailOff) {
-    
+    if (allowTailOff) {
+        bank.releaseVoice (slot);
+    } else {
+        bank.stopVoice (slot);
+        clearCurrentNote();
+    }
 }
 void SynthVoice::controllerMoved (int controllerNumber, int newControllerValue) {
     
 }
 
 void SynthVoice::pitchWheelMoved (int newPitchWheelValue){
-    
+    pitchWheelPosition = newPitchWheelValue;
+
+    if (isVoiceActive())
+        bank.setFrequency (slot, getFrequency (getCurrentlyPlayingNote()));
 }
 
 void SynthVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int startSample, int numSamples) {
-    
+    // Never called: BankSynthesiser renders every voice through the bank.
+}
+
+float SynthVoice::getFrequency (int midiNoteNumber) const {
+    // Two semitones either way.
+    auto semitones = (pitchWheelPosition - 8192) / 8192.0 * 2.0;
+    return (float) (juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber) * std::exp2 (semitones / 12.0));
+}
+
+//==============================================================================
+BankSynthesiser::BankSynthesiser() {
+    for (int i = 0; i < VoiceBank::maxVoices; ++i)
+        addVoice (new SynthVoice (bank, i));
+}
+
+void BankSynthesiser::prepare (double sampleRate, int maxBlockSize) {
+    // The bank drops every voice as it is prepared, so let go of their notes first.
+    allNotesOff (0, false);
+
+    setCurrentPlaybackSampleRate (sampleRate);
+    bank.prepare (sampleRate, maxBlockSize);
+}
+
+void BankSynthesiser::setSettings (const VoiceBank::Settings& settings) {
+    bank.setSettings (settings);
+}
+
+void BankSynthesiser::setRoutes (const ModMatrix::Routes& routes) {
+    bank.setRoutes (routes);
+}
+
+void BankSynthesiser::renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) {
+    bank.render (outputAudio, startSample, numSamples);
+
+    for (auto voice : bank.getFinishedVoices())
+        getVoice (voice)->clearCurrentNote();
 }
@@ -12,19 +12,50 @@
 
 #include <JuceHeader.h>
 #include "synthsound.h"
+#include "voicebank.h"
 
+/** One slot of a VoiceBank, as far as juce::Synthesiser is concerned: it takes
+    the notes it is given into its slot, and leaves rendering to the bank.
+*/
 class SynthVoice : public juce::SynthesiserVoice
 {
 public:
+    SynthVoice (VoiceBank& bank, int slot);
+
     bool canPlaySound (juce::SynthesiserSound *sound) override;
     void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition) override;
     void stopNote (float velocity, bool allowTailOff) override;
     void controllerMoved (int controllerNumber, int newControllerValue) override;
     void pitchWheelMoved (int newPitchWheelValue) override;
-    void prepare
     void renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int startSample, int numSamples) override;
     
 private:
-    juce::dsp::Oscillator<float> osc{ [](float x) { return std::sin(x);}};
-    juce::dsp::Gain<float> gain;
+    float getFrequency (int midiNoteNumber) const;
+
+    VoiceBank& bank;
+    int slot;
+    int pitchWheelPosition = 8192;
+};
+
+/** A juce::Synthesiser whose voices are the slots of one VoiceBank. The bank
+    renders them all in one go, instead of one renderNextBlock() call per voice,
+    and hands back the voices whose release has ended.
+*/
+class BankSynthesiser : public juce::Synthesiser
+{
+public:
+    BankSynthesiser();
+
+    void prepare (double sampleRate, int maxBlockSize);
+
+    /** Pass-throughs to the bank, for the audio thread between blocks. Neither
+        allocates.
+    */
+    void setSettings (const VoiceBank::Settings&);
+    void setRoutes (const ModMatrix::Routes&);
+
+private:
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+    VoiceBank bank;
 };
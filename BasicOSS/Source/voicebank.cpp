@@ -0,0 +1,776 @@
+/*
+  ==============================================================================
+
+    voicebank.cpp
+    Created: 18 Oct 2026 10:41:15am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "voicebank.h"
+
+namespace
+{
+    constexpr std::uint64_t passMask = (std::uint64_t (1) << VoiceBank::voicesPerPass) - 1;
+
+    constexpr std::uint64_t voiceBit (int voice)
+    {
+        return std::uint64_t (1) << voice;
+    }
+
+    struct Lowpass
+    {
+        float a1, a2, a3;
+    };
+
+    Lowpass makeLowpass (double sampleRate, double cutoffHz, double damping)
+    {
+        auto cutoff = juce::jlimit (10.0, sampleRate * 0.45, cutoffHz);
+        auto g = std::tan (juce::MathConstants<double>::pi * cutoff / sampleRate);
+        auto a1 = 1.0 / (1.0 + g * (g + damping));
+
+        return { (float) a1, (float) (g * a1), (float) (g * g * a1) };
+    }
+
+    /** 2 to the x, for x within 2 either way, from a polynomial for a quarter
+        of x squared twice; good to a fraction of a cent.
+    */
+    template <typename Vec>
+    Vec exp2Approximation (Vec x) noexcept
+    {
+        auto y = Vec::min (Vec (2.f), Vec::max (Vec (-2.f), x)) * Vec (0.25f);
+        auto p = Vec (1.f) + y * (Vec (0.693147f) + y * (Vec (0.240227f) + y * (Vec (0.0555041f) + y * Vec (0.00961813f))));
+        p *= p;
+        return p * p;
+    }
+}
+
+VoiceBank::VoiceBank()
+{
+    finishedVoices.reserve ((size_t) maxVoices);
+}
+
+void VoiceBank::prepare (double newSampleRate, int maxBlockSize)
+{
+    sampleRate = newSampleRate;
+
+    laneMix.resize ((size_t) maxBlockSize);
+    laneEnvelope.resize ((size_t) maxBlockSize);
+    laneModEnvelope.resize ((size_t) maxBlockSize);
+    mix.resize ((size_t) maxBlockSize);
+
+    envelopes.prepare (sampleRate);
+    modEnvelopes.prepare (sampleRate);
+    activeVoices = 0;
+}
+
+void VoiceBank::setSettings (const Settings& newSettings)
+{
+    settings = newSettings;
+    envelopes.setParameters (settings.envelope);
+    modEnvelopes.setParameters (settings.modEnvelope);
+}
+
+void VoiceBank::setRoutes (const ModMatrix::Routes& routes)
+{
+    matrix.setRoutes (routes);
+
+    for (size_t v = 0; v < (size_t) maxVoices; ++v)
+    {
+        if (! matrix.isControlled (ModMatrix::Destination::Pitch))
+            pitchRatio[v] = pitchInverse[v] = 1.f;
+
+        if (! matrix.isControlled (ModMatrix::Destination::Amplitude))
+            gain[v] = 1.f;
+
+        if (! matrix.isControlled (ModMatrix::Destination::PulseWidth))
+            pulseWidth[v] = basePulseWidth[v];
+
+        if (! matrix.isControlled (ModMatrix::Destination::Cutoff))
+        {
+            auto lowpass = makeLowpass (sampleRate, baseCutoff[v], damping[v]);
+            filterA1[v] = lowpass.a1;
+            filterA2[v] = lowpass.a2;
+            filterA3[v] = lowpass.a3;
+        }
+    }
+}
+
+void VoiceBank::startVoice (int voice, float frequency, float velocity)
+{
+    jassert (juce::isPositiveAndBelow (voice, maxVoices));
+    auto v = (size_t) voice;
+
+    phase[v] = masterPhase[v] = heldSample[v] = 0.f;
+    pulseWidth[v] = basePulseWidth[v] = juce::jlimit (0.05f, 0.95f, settings.pulseWidth);
+    setFrequency (voice, frequency);
+    amplitude[v] = velocity * settings.level;
+
+    envelopes.reset (voice);
+    envelopes.noteOn (voice);
+    modEnvelopes.reset (voice);
+    modEnvelopes.noteOn (voice);
+
+    pitchRatio[v] = pitchInverse[v] = gain[v] = 1.f;
+
+    for (auto& lfo : lfoPhase)
+        lfo[v] = 0.f;
+
+    baseCutoff[v] = juce::jlimit (10.f, (float) (sampleRate * 0.45), settings.cutoffHz);
+    damping[v] = 1.f / juce::jmax (0.1f, settings.resonance);
+
+    auto lowpass = makeLowpass (sampleRate, baseCutoff[v], damping[v]);
+    filterA1[v] = lowpass.a1;
+    filterA2[v] = lowpass.a2;
+    filterA3[v] = lowpass.a3;
+    filterIc1[v] = filterIc2[v] = 0.f;
+
+    activeVoices |= voiceBit (voice);
+}
+
+void VoiceBank::releaseVoice (int voice)
+{
+    if (isVoiceActive (voice))
+    {
+        envelopes.noteOff (voice);
+        modEnvelopes.noteOff (voice);
+    }
+}
+
+void VoiceBank::stopVoice (int voice)
+{
+    activeVoices &= ~voiceBit (voice);
+
+    // A stopped lane can still be rendered alongside playing ones; silence it.
+    amplitude[(size_t) voice] = 0.f;
+    envelopes.reset (voice);
+    modEnvelopes.reset (voice);
+}
+
+void VoiceBank::setFrequency (int voice, float frequency)
+{
+    increment[(size_t) voice] = (float) juce::jlimit (0.0, 0.5, frequency / sampleRate);
+}
+
+void VoiceBank::render (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    finishedVoices.clear();
+
+    // In chunks, in case the host goes over the block size it announced.
+    for (auto maxChunk = (int) mix.size(); numSamples > 0 && activeVoices != 0; startSample += maxChunk, numSamples -= maxChunk)
+    {
+        auto numChunkSamples = juce::jmin (numSamples, maxChunk);
+        std::fill (laneMix.begin(), laneMix.begin() + numChunkSamples, Vec (0.f));
+
+        auto renderOscillatorPass = getPassRenderer<TableOscillator>();
+
+        if (settings.oscillator == Oscillator::Analytic)
+        {
+            switch (settings.shape)
+            {
+                case WavetableSet::Shape::Saw:       renderOscillatorPass = getPassRenderer<AnalyticOscillator<WavetableSet::Shape::Saw>>(); break;
+                case WavetableSet::Shape::Square:    renderOscillatorPass = getPassRenderer<AnalyticOscillator<WavetableSet::Shape::Square>>(); break;
+                case WavetableSet::Shape::Triangle:  renderOscillatorPass = getPassRenderer<AnalyticOscillator<WavetableSet::Shape::Triangle>>(); break;
+                case WavetableSet::Shape::Sine:      break;
+            }
+        }
+
+        for (int pass = 0; pass < numPasses; ++pass)
+            if ((activeVoices >> (pass * voicesPerPass)) & passMask)
+                (this->*renderOscillatorPass) (pass, numChunkSamples);
+
+        for (int i = 0; i < numChunkSamples; ++i)
+            mix[(size_t) i] = laneMix[(size_t) i].sum();
+
+        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+            outputBuffer.addFrom (channel, startSample, mix.data(), numChunkSamples);
+
+        auto finished = envelopes.takeFinishedVoices();
+
+        for (int voice = 0; voice < maxVoices && (finished >> voice) != 0; ++voice)
+        {
+            if ((finished & voiceBit (voice)) != 0)
+            {
+                stopVoice (voice);
+                finishedVoices.push_back (voice);
+            }
+        }
+    }
+}
+
+//==============================================================================
+/** Reads each lane's table for the bank's shape, at the level for its pitch. */
+class VoiceBank::TableOscillator
+{
+public:
+    TableOscillator (VoiceBank& b, size_t firstVoice)
+        : bank (b), first (firstVoice),
+          phase (Vec::fromRawArray (bank.phase.data() + first)),
+          baseIncrement (Vec::fromRawArray (bank.increment.data() + first)),
+          increment (baseIncrement)
+    {
+        selectTables (one);
+    }
+
+    /** Picks each lane's table for the highest pitch ratio it will be played at. */
+    void selectTables (Vec highestRatio) noexcept
+    {
+        auto highest = baseIncrement * highestRatio;
+
+        for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+            tables[lane] = bank.wavetables->getSamples()
+                         + bank.wavetables->getTableOffset (bank.settings.shape, highest.get (lane));
+    }
+
+    /** Kept at or below Nyquist, so that one wrap a sample keeps the phase in the table. */
+    void setPitch (Vec ratio, Vec) noexcept
+    {
+        increment = Vec::min (half, baseIncrement * ratio);
+    }
+
+    void setPulseWidth (Vec) noexcept {}
+
+    Vec getNextSample() noexcept
+    {
+        phase += increment;
+        phase -= one & Vec::greaterThanOrEqual (phase, one);
+
+        auto position = phase * size;
+        auto whole = Vec::truncate (position);
+        whole.copyToRawArray (index);
+
+        for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+        {
+            auto* sample = tables[lane] + (int) index[lane];
+            lower[lane] = sample[0];
+            upper[lane] = sample[1];
+        }
+
+        auto y0 = Vec::fromRawArray (lower);
+        return y0 + (position - whole) * (Vec::fromRawArray (upper) - y0);
+    }
+
+    void store() const noexcept
+    {
+        phase.copyToRawArray (bank.phase.data() + first);
+    }
+
+private:
+    VoiceBank& bank;
+    size_t first;
+
+    const Vec one { 1.f }, half { 0.5f }, size { (float) WavetableSet::tableSize };
+    Vec phase, baseIncrement, increment;
+
+    const float* tables[voicesPerPass];
+
+    alignas (Vec::SIMDRegisterSize) float index[voicesPerPass];
+    alignas (Vec::SIMDRegisterSize) float lower[voicesPerPass];
+    alignas (Vec::SIMDRegisterSize) float upper[voicesPerPass];
+};
+
+//==============================================================================
+/** A saw, pulse or triangle worked out from its phase, with PolyBlep smoothing
+    every jump in value or slope, including the ones hard sync makes.
+
+    In a sample where the master wraps, the oscillator's phase runs up to the
+    moment of the wrap, when it jumps back to zero and carries on from there.
+    Corners before the sync are placed from the phase before it, and those
+    after from the phase after it, so each lands at its true sub-sample time.
+*/
+template <WavetableSet::Shape shape>
+class VoiceBank::AnalyticOscillator
+{
+public:
+    AnalyticOscillator (VoiceBank& b, size_t firstVoice)
+        : bank (b), first (firstVoice),
+          phase (Vec::fromRawArray (bank.phase.data() + first)),
+          masterPhase (Vec::fromRawArray (bank.masterPhase.data() + first)),
+          pulseWidth (Vec::fromRawArray (bank.pulseWidth.data() + first)),
+          held (Vec::fromRawArray (bank.heldSample.data() + first))
+    {
+        auto isSynced = bank.settings.syncRatio > 1.001f;
+
+        // There's no vector division, so the reciprocals are worked out here, once a block.
+        for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+        {
+            auto noteIncrement = bank.increment[first + lane];
+            auto slaveIncrement = isSynced ? juce::jmin (0.5f, noteIncrement * bank.settings.syncRatio) : noteIncrement;
+
+            baseIncrement.set (lane, slaveIncrement);
+            baseReciprocal.set (lane, 1.f / juce::jmax (slaveIncrement, 1.0e-9f));
+            baseMasterIncrement.set (lane, isSynced ? noteIncrement : 0.f);
+            baseMasterReciprocal.set (lane, 1.f / juce::jmax (noteIncrement, 1.0e-9f));
+        }
+
+        setPitch (one, one);
+    }
+
+    void selectTables (Vec) noexcept {}
+
+    /** Scales the pitch by ratio, given its inverse too, as there's no vector division. */
+    void setPitch (Vec ratio, Vec inverse) noexcept
+    {
+        increment = Vec::min (half, baseIncrement * ratio);
+        reciprocal = baseReciprocal * inverse;
+        masterIncrement = Vec::min (half, baseMasterIncrement * ratio);
+        masterReciprocal = baseMasterReciprocal * inverse;
+    }
+
+    void setPulseWidth (Vec width) noexcept
+    {
+        pulseWidth = width;
+    }
+
+    Vec getNextSample() noexcept
+    {
+        masterPhase += masterIncrement;
+        auto isSync = Vec::greaterThanOrEqual (masterPhase, one);
+        masterPhase -= one & isSync;
+
+        // How long ago the sync was, or zero if there wasn't one.
+        auto syncTime = (masterPhase * masterReciprocal) & isSync;
+
+        // The phase reached before the sync, or by the end of the sample, not yet wrapped.
+        auto end = phase + increment * (one - syncTime);
+        auto restartedPhase = increment * syncTime;
+
+        PolyBlep<Vec> blep;
+        auto isWrapped = Vec::greaterThanOrEqual (end, one);
+        auto wrapTime = (end - one) * reciprocal + syncTime;
+        auto before = end - (one & isWrapped);
+
+        if constexpr (shape == WavetableSet::Shape::Saw)
+        {
+            blep.addStep (isWrapped, wrapTime, Vec (-2.f));
+            blep.addStep (isSync, syncTime, Vec (-2.f) * before);
+        }
+        else if constexpr (shape == WavetableSet::Shape::Square)
+        {
+            blep.addStep (isWrapped, wrapTime, Vec (2.f));
+
+            // Falling at the pulse width, possibly once more after a wrap, or after the sync.
+            auto isCrossed = Vec::lessThan (phase, pulseWidth) & Vec::greaterThanOrEqual (end, pulseWidth);
+            blep.addStep (isCrossed, (end - pulseWidth) * reciprocal + syncTime, Vec (-2.f));
+
+            auto isCrossedAgain = Vec::greaterThanOrEqual (end, pulseWidth + one);
+            blep.addStep (isCrossedAgain, (end - pulseWidth - one) * reciprocal + syncTime, Vec (-2.f));
+
+            auto isCrossedAfterSync = isSync & Vec::greaterThanOrEqual (restartedPhase, pulseWidth);
+            blep.addStep (isCrossedAfterSync, (restartedPhase - pulseWidth) * reciprocal, Vec (-2.f));
+
+            blep.addStep (isSync, syncTime, two & Vec::greaterThanOrEqual (before, pulseWidth));
+        }
+        else
+        {
+            // Corners at a quarter (to falling) and three quarters (to rising) of the cycle.
+            auto slopeChange = increment * Vec (8.f);
+
+            for (auto corner : { 0.25f, 0.75f, 1.25f })
+            {
+                auto isCrossed = Vec::lessThan (phase, Vec (corner)) & Vec::greaterThanOrEqual (end, Vec (corner));
+                blep.addRamp (isCrossed, (end - Vec (corner)) * reciprocal + syncTime, corner == 0.75f ? slopeChange : Vec (0.f) - slopeChange);
+            }
+
+            auto isCrossedAfterSync = isSync & Vec::greaterThanOrEqual (restartedPhase, quarter);
+            blep.addRamp (isCrossedAfterSync, (restartedPhase - quarter) * reciprocal, Vec (0.f) - slopeChange);
+
+            // Back to zero and rising, from wherever the sync caught it.
+            auto isFalling = Vec::greaterThanOrEqual (before, quarter) & Vec::lessThan (before, threeQuarters);
+            blep.addStep (isSync, syncTime, Vec (0.f) - getTriangle (before));
+            blep.addRamp (isSync & isFalling, syncTime, slopeChange);
+        }
+
+        phase = before + ((restartedPhase - before) & isSync);
+
+        auto output = held + blep.previous;
+        held = getNaiveSample() + blep.current;
+        return output;
+    }
+
+    void store() const noexcept
+    {
+        phase.copyToRawArray (bank.phase.data() + first);
+        masterPhase.copyToRawArray (bank.masterPhase.data() + first);
+        held.copyToRawArray (bank.heldSample.data() + first);
+    }
+
+private:
+    Vec getNaiveSample() const noexcept
+    {
+        if constexpr (shape == WavetableSet::Shape::Saw)
+            return phase * two - one;
+        else if constexpr (shape == WavetableSet::Shape::Square)
+            return one - (two & Vec::greaterThanOrEqual (phase, pulseWidth));
+        else
+            return getTriangle (phase);
+    }
+
+    /** Zero at the start of the cycle and rising, like the table's. */
+    Vec getTriangle (Vec p) const noexcept
+    {
+        auto q = p + quarter - (one & Vec::greaterThanOrEqual (p, threeQuarters));
+        return one - Vec (4.f) * Vec::abs (q - Vec (0.5f));
+    }
+
+    VoiceBank& bank;
+    size_t first;
+
+    const Vec one { 1.f }, two { 2.f }, half { 0.5f }, quarter { 0.25f }, threeQuarters { 0.75f };
+
+    Vec phase, masterPhase, pulseWidth, held;
+    Vec baseIncrement, baseReciprocal, baseMasterIncrement, baseMasterReciprocal;
+    Vec increment, reciprocal, masterIncrement, masterReciprocal;
+};
+
+//==============================================================================
+/** A pass's modulation. The control rate routes are evaluated from the sources
+    at the end of each sub-block, and every destination they reach ramps there
+    linearly across it; the audio rate routes are then applied on top of the
+    ramps, sample by sample. Nothing is worked out for a destination that no
+    route reaches.
+*/
+class VoiceBank::Modulation
+{
+public:
+    Modulation (VoiceBank& b, size_t firstVoice)
+        : bank (b), first (firstVoice), matrix (bank.matrix),
+          pitch (Vec::fromRawArray (bank.pitchRatio.data() + first)),
+          inverse (Vec::fromRawArray (bank.pitchInverse.data() + first)),
+          gain (Vec::fromRawArray (bank.gain.data() + first)),
+          width (Vec::fromRawArray (bank.pulseWidth.data() + first)),
+          a1 (Vec::fromRawArray (bank.filterA1.data() + first)),
+          a2 (Vec::fromRawArray (bank.filterA2.data() + first)),
+          a3 (Vec::fromRawArray (bank.filterA3.data() + first)),
+          baseWidth (Vec::fromRawArray (bank.basePulseWidth.data() + first))
+    {
+        for (size_t k = 0; k < (size_t) numLfos; ++k)
+        {
+            lfoPhase[k] = Vec::fromRawArray (bank.lfoPhase[k].data() + first);
+            lfoIncrement[k] = Vec ((float) juce::jlimit (0.0, 0.5 / EnvelopeBank::controlPeriod,
+                                                         bank.settings.lfos[k].rateHz / bank.sampleRate));
+        }
+
+        hasControlRoutes = ! matrix.getControlConnections().empty();
+        hasAudioRoutes = ! matrix.getAudioConnections().empty();
+        audioPitchHeadroom = Vec (std::exp2 (matrix.getAudioDepth (ModMatrix::Destination::Pitch) / 12.f));
+
+        updateOutputs();
+    }
+
+    /** Works out the control rate routes for the sub-block of length samples
+        from start, and the steps to ramp to them.
+    */
+    void startSubBlock (int start, int length)
+    {
+        auto end = (size_t) (start + length - 1);
+        std::array<Vec, (size_t) ModMatrix::numSources> sources {};
+
+        for (size_t k = 0; k < (size_t) numLfos; ++k)
+        {
+            auto source = getLfoSource (k);
+
+            if (! matrix.usesSource (source))
+                continue;
+
+            subBlockLfoPhase[k] = lfoPhase[k];
+            lfoPhase[k] = wrap (lfoPhase[k] + lfoIncrement[k] * Vec ((float) length));
+
+            if (matrix.usesControlSource (source))
+                sources[(size_t) source] = ModMatrix::getLfoValue (bank.settings.lfos[k].shape, lfoPhase[k]);
+        }
+
+        sources[(size_t) ModMatrix::Source::Envelope] = bank.laneEnvelope[end];
+        sources[(size_t) ModMatrix::Source::ModEnvelope] = bank.laneModEnvelope[end];
+
+        if (! hasControlRoutes)
+        {
+            highestPitch = pitch * audioPitchHeadroom;
+            return;
+        }
+
+        std::array<Vec, (size_t) ModMatrix::numDestinations> targets {};
+        ModMatrix::apply (matrix.getControlConnections(), sources.data(), targets.data());
+
+        const Vec scale (1.f / (float) length);
+        auto target = [&] (ModMatrix::Destination d) -> Vec& { return targets[(size_t) d]; };
+
+        if (matrix.isControlled (ModMatrix::Destination::Pitch))
+        {
+            Vec ratio, ratioInverse;
+
+            for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+            {
+                auto semitones = juce::jlimit (-48.f, 48.f, target (ModMatrix::Destination::Pitch).get (lane));
+                ratio.set (lane, std::exp2 (semitones / 12.f));
+                ratioInverse.set (lane, 1.f / ratio.get (lane));
+            }
+
+            pitchStep = (ratio - pitch) * scale;
+            inverseStep = (ratioInverse - inverse) * scale;
+            highestPitch = Vec::max (pitch, ratio) * audioPitchHeadroom;
+        }
+        else
+        {
+            highestPitch = pitch * audioPitchHeadroom;
+        }
+
+        if (matrix.isControlled (ModMatrix::Destination::Cutoff))
+        {
+            Vec b1, b2, b3;
+
+            for (size_t lane = 0; lane < (size_t) voicesPerPass; ++lane)
+            {
+                auto octaves = juce::jlimit (-10.f, 10.f, target (ModMatrix::Destination::Cutoff).get (lane));
+                auto lowpass = makeLowpass (bank.sampleRate,
+                                            bank.baseCutoff[first + lane] * std::exp2 (octaves),
+                                            bank.damping[first + lane]);
+                b1.set (lane, lowpass.a1);
+                b2.set (lane, lowpass.a2);
+                b3.set (lane, lowpass.a3);
+            }
+
+            a1Step = (b1 - a1) * scale;
+            a2Step = (b2 - a2) * scale;
+            a3Step = (b3 - a3) * scale;
+        }
+
+        if (matrix.isControlled (ModMatrix::Destination::Amplitude))
+            gainStep = (Vec::max (zero, one + target (ModMatrix::Destination::Amplitude)) - gain) * scale;
+
+        if (matrix.isControlled (ModMatrix::Destination::PulseWidth))
+            widthStep = (limitWidth (baseWidth + target (ModMatrix::Destination::PulseWidth)) - width) * scale;
+    }
+
+    /** Moves on to sample i of the block. */
+    void advance (int i) noexcept
+    {
+        if (hasControlRoutes)
+        {
+            if (matrix.isControlled (ModMatrix::Destination::Pitch))
+            {
+                pitch += pitchStep;
+                inverse += inverseStep;
+            }
+
+            if (matrix.isControlled (ModMatrix::Destination::Cutoff))
+            {
+                a1 += a1Step;
+                a2 += a2Step;
+                a3 += a3Step;
+            }
+
+            if (matrix.isControlled (ModMatrix::Destination::Amplitude))
+                gain += gainStep;
+
+            if (matrix.isControlled (ModMatrix::Destination::PulseWidth))
+                width += widthStep;
+        }
+
+        if (hasAudioRoutes)
+            applyAudioRoutes ((size_t) i);
+        else if (hasControlRoutes)
+            updateOutputs();
+    }
+
+    /** The most the pitch ratio will reach in this sub-block. */
+    Vec getHighestPitch() const noexcept        { return highestPitch; }
+
+    Vec getPitch() const noexcept               { return outputPitch; }
+    Vec getInverse() const noexcept             { return outputInverse; }
+    Vec getGain() const noexcept                { return outputGain; }
+    Vec getPulseWidth() const noexcept          { return outputWidth; }
+
+    Vec getA1() const noexcept                  { return a1; }
+    Vec getA2() const noexcept                  { return a2; }
+    Vec getA3() const noexcept                  { return a3; }
+
+    void store() const noexcept
+    {
+        pitch.copyToRawArray (bank.pitchRatio.data() + first);
+        inverse.copyToRawArray (bank.pitchInverse.data() + first);
+        gain.copyToRawArray (bank.gain.data() + first);
+        width.copyToRawArray (bank.pulseWidth.data() + first);
+        a1.copyToRawArray (bank.filterA1.data() + first);
+        a2.copyToRawArray (bank.filterA2.data() + first);
+        a3.copyToRawArray (bank.filterA3.data() + first);
+
+        for (size_t k = 0; k < (size_t) numLfos; ++k)
+            lfoPhase[k].copyToRawArray (bank.lfoPhase[k].data() + first);
+    }
+
+private:
+    static ModMatrix::Source getLfoSource (size_t k) noexcept
+    {
+        return k == 0 ? ModMatrix::Source::Lfo1 : ModMatrix::Source::Lfo2;
+    }
+
+    Vec wrap (Vec p) const noexcept
+    {
+        return p - (one & Vec::greaterThanOrEqual (p, one));
+    }
+
+    Vec limitWidth (Vec w) const noexcept
+    {
+        return Vec::min (Vec (0.95f), Vec::max (Vec (0.05f), w));
+    }
+
+    void applyAudioRoutes (size_t i) noexcept
+    {
+        std::array<Vec, (size_t) ModMatrix::numSources> sources {};
+
+        for (size_t k = 0; k < (size_t) numLfos; ++k)
+        {
+            auto source = getLfoSource (k);
+
+            if (matrix.usesAudioSource (source))
+            {
+                subBlockLfoPhase[k] = wrap (subBlockLfoPhase[k] + lfoIncrement[k]);
+                sources[(size_t) source] = ModMatrix::getLfoValue (bank.settings.lfos[k].shape, subBlockLfoPhase[k]);
+            }
+        }
+
+        sources[(size_t) ModMatrix::Source::Envelope] = bank.laneEnvelope[i];
+        sources[(size_t) ModMatrix::Source::ModEnvelope] = bank.laneModEnvelope[i];
+
+        std::array<Vec, (size_t) ModMatrix::numDestinations> amounts {};
+        ModMatrix::apply (matrix.getAudioConnections(), sources.data(), amounts.data());
+
+        updateOutputs();
+
+        if (matrix.isAudioModulated (ModMatrix::Destination::Pitch))
+        {
+            auto octaves = amounts[(size_t) ModMatrix::Destination::Pitch] * Vec (1.f / 12.f);
+            outputPitch *= exp2Approximation (octaves);
+            outputInverse *= exp2Approximation (zero - octaves);
+        }
+
+        if (matrix.isAudioModulated (ModMatrix::Destination::Amplitude))
+            outputGain *= Vec::max (zero, one + amounts[(size_t) ModMatrix::Destination::Amplitude]);
+
+        if (matrix.isAudioModulated (ModMatrix::Destination::PulseWidth))
+            outputWidth = limitWidth (outputWidth + amounts[(size_t) ModMatrix::Destination::PulseWidth]);
+    }
+
+    void updateOutputs() noexcept
+    {
+        outputPitch = pitch;
+        outputInverse = inverse;
+        outputGain = gain;
+        outputWidth = width;
+    }
+
+    VoiceBank& bank;
+    size_t first;
+    const ModMatrix& matrix;
+
+    const Vec zero { 0.f }, one { 1.f };
+
+    // The ramps, and their steps per sample.
+    Vec pitch, inverse, gain, width, a1, a2, a3;
+    Vec pitchStep, inverseStep, gainStep, widthStep, a1Step, a2Step, a3Step;
+
+    Vec baseWidth, highestPitch, audioPitchHeadroom;
+    Vec outputPitch, outputInverse, outputGain, outputWidth;
+
+    std::array<Vec, (size_t) numLfos> lfoPhase, lfoIncrement, subBlockLfoPhase;
+    bool hasControlRoutes = false, hasAudioRoutes = false;
+};
+
+//==============================================================================
+template <typename Oscillator>
+VoiceBank::PassRenderer VoiceBank::getPassRenderer() const noexcept
+{
+    // With no routes at all, the modulation isn't even compiled in.
+    if (matrix.getControlConnections().empty() && matrix.getAudioConnections().empty())
+        return &VoiceBank::renderPass<Oscillator, false>;
+
+    return &VoiceBank::renderPass<Oscillator, true>;
+}
+
+template <typename Oscillator, bool isModulated>
+void VoiceBank::renderPass (int pass, int numSamples)
+{
+    auto first = (size_t) (pass * voicesPerPass);
+
+    envelopes.process ((int) first, laneEnvelope.data(), numSamples);
+
+    if (isModulated && matrix.usesSource (ModMatrix::Source::ModEnvelope))
+        modEnvelopes.process ((int) first, laneModEnvelope.data(), numSamples);
+
+    Oscillator oscillator (*this, first);
+
+    auto voiceAmplitude = Vec::fromRawArray (amplitude.data() + first);
+    auto a1 = Vec::fromRawArray (filterA1.data() + first);
+    auto a2 = Vec::fromRawArray (filterA2.data() + first);
+    auto a3 = Vec::fromRawArray (filterA3.data() + first);
+    auto ic1 = Vec::fromRawArray (filterIc1.data() + first);
+    auto ic2 = Vec::fromRawArray (filterIc2.data() + first);
+
+    const auto two = Vec (2.f);
+
+    auto renderSample = [&] (int i, Vec level)
+    {
+        auto y = oscillator.getNextSample();
+
+        auto v3 = y - ic2;
+        auto v1 = a1 * ic1 + a2 * v3;
+        auto v2 = ic2 + a2 * ic1 + a3 * v3;
+        ic1 = two * v1 - ic1;
+        ic2 = two * v2 - ic2;
+
+        laneMix[(size_t) i] += v2 * level;
+    };
+
+    if constexpr (isModulated)
+    {
+        Modulation modulation (*this, first);
+
+        auto isPitchModulated = matrix.isModulated (ModMatrix::Destination::Pitch);
+        auto isCutoffModulated = matrix.isModulated (ModMatrix::Destination::Cutoff);
+        auto isGainModulated = matrix.isModulated (ModMatrix::Destination::Amplitude);
+        auto isWidthModulated = matrix.isModulated (ModMatrix::Destination::PulseWidth);
+
+        for (int start = 0; start < numSamples; start += EnvelopeBank::controlPeriod)
+        {
+            auto end = juce::jmin (numSamples, start + EnvelopeBank::controlPeriod);
+            modulation.startSubBlock (start, end - start);
+
+            if (isPitchModulated)
+                oscillator.selectTables (modulation.getHighestPitch());
+
+            for (int i = start; i < end; ++i)
+            {
+                modulation.advance (i);
+
+                if (isPitchModulated)
+                    oscillator.setPitch (modulation.getPitch(), modulation.getInverse());
+
+                if (isWidthModulated)
+                    oscillator.setPulseWidth (modulation.getPulseWidth());
+
+                if (isCutoffModulated)
+                {
+                    a1 = modulation.getA1();
+                    a2 = modulation.getA2();
+                    a3 = modulation.getA3();
+                }
+
+                auto level = laneEnvelope[(size_t) i] * voiceAmplitude;
+                renderSample (i, isGainModulated ? level * modulation.getGain() : level);
+            }
+        }
+
+        modulation.store();
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+            renderSample (i, laneEnvelope[(size_t) i] * voiceAmplitude);
+    }
+
+    oscillator.store();
+    ic1.copyToRawArray (filterIc1.data() + first);
+    ic2.copyToRawArray (filterIc2.data() + first);
+}
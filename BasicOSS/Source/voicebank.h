@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    voicebank.h
+    Created: 18 Oct 2026 10:41:15am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "wavetable.h"
+#include "polyblep.h"
+#include "envelopebank.h"
+#include "modmatrix.h"
+
+//==============================================================================
+/**
+    The state of every voice, kept as one array per field rather than one object
+    per voice, so that a single pass renders a SIMD register's worth of voices.
+
+    Voices are numbered slots. A pass covers voicesPerPass neighbouring slots,
+    and passes with no voice playing are skipped, so it pays to start notes in
+    the lowest free slot, as juce::Synthesiser does. A voice's state stays in
+    registers for the whole block, and each pass adds into one lane-wide mix,
+    which is only summed across lanes once per sample at the end.
+
+    Oscillators either read the shared WavetableSet, with the table positions
+    and the interpolation worked out for all lanes at once and only the fetch
+    of each lane's two samples done lane by lane, or are worked out from their
+    phase, with PolyBlep smoothing their corners. The analytic ones use no
+    memory but their own state, and are the ones that can be hard synced.
+
+    Each voice has its own LFOs, restarted with its note, and a second envelope
+    for modulation, which are routed through a ModMatrix. A pass is worked out
+    in sub-blocks of a control period: the control rate routes are evaluated at
+    the end of each and ramped to, and only the audio rate ones run per sample.
+*/
+class VoiceBank
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxVoices = 64;
+    static constexpr int voicesPerPass = (int) Vec::size();
+    static constexpr int numPasses = maxVoices / voicesPerPass;
+    static constexpr int numLfos = 2;
+
+    static_assert (maxVoices % voicesPerPass == 0 && maxVoices <= 64, "Voices are tracked in one 64-bit mask");
+    static_assert (maxVoices <= EnvelopeBank::maxVoices && voicesPerPass == EnvelopeBank::voicesPerPass, "Every voice needs an envelope");
+
+    enum class Oscillator
+    {
+        Wavetable,
+        Analytic        // for Saw, Square and Triangle; Sine always comes from its table
+    };
+
+    struct Lfo
+    {
+        ModMatrix::LfoShape shape = ModMatrix::LfoShape::Sine;
+        float rateHz = 5.f;
+    };
+
+    /** The shape, oscillator, sync, envelopes and LFOs apply to every voice from
+        the next block; the rest to each voice as it starts.
+    */
+    struct Settings
+    {
+        WavetableSet::Shape shape = WavetableSet::Shape::Saw;
+        Oscillator oscillator = Oscillator::Wavetable;
+        float pulseWidth = 0.5f;        // of Square, for the analytic oscillator
+        float syncRatio = 1.f;          // pitch over that of the master it is hard synced to; 1 for no sync
+
+        EnvelopeBank::Parameters envelope;
+        EnvelopeBank::Parameters modEnvelope;
+        std::array<Lfo, (size_t) numLfos> lfos;
+
+        float cutoffHz = 8000.f;
+        float resonance = 0.707f;
+        float level = 0.2f;
+    };
+
+    VoiceBank();
+
+    void prepare (double sampleRate, int maxBlockSize);
+    void setSettings (const Settings&);
+
+    /** Recompiles the modulation routes. Destinations that are no longer
+        routed at control rate go back to where their voices started.
+    */
+    void setRoutes (const ModMatrix::Routes&);
+
+    void startVoice (int voice, float frequency, float velocity);
+    void releaseVoice (int voice);
+    void stopVoice (int voice);
+    void setFrequency (int voice, float frequency);
+
+    bool isVoiceActive (int voice) const noexcept           { return (activeVoices >> voice) & 1; }
+
+    /** Adds every playing voice into all the buffer's channels. */
+    void render (juce::AudioBuffer<float>&, int startSample, int numSamples);
+
+    /** The voices whose release ended during the last render(), as reported by
+        their envelopes. They are already stopped here; this is for whoever
+        hands out the voices.
+    */
+    const std::vector<int>& getFinishedVoices() const noexcept  { return finishedVoices; }
+
+private:
+    class TableOscillator;
+    template <WavetableSet::Shape> class AnalyticOscillator;
+    class Modulation;
+
+    using PassRenderer = void (VoiceBank::*) (int, int);
+
+    template <typename Oscillator>
+    PassRenderer getPassRenderer() const noexcept;
+
+    template <typename Oscillator, bool isModulated>
+    void renderPass (int pass, int numSamples);
+
+    using VoiceArray = std::array<float, (size_t) maxVoices>;
+
+    alignas (Vec::SIMDRegisterSize) VoiceArray phase {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray increment {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray pulseWidth {};
+
+    // For the analytic oscillators: the phase of the master driving hard sync,
+    // and each voice's latest sample, which is held back by one.
+    alignas (Vec::SIMDRegisterSize) VoiceArray masterPhase {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray heldSample {};
+
+    alignas (Vec::SIMDRegisterSize) VoiceArray amplitude {};
+
+    // What each voice's note started with, before modulation.
+    alignas (Vec::SIMDRegisterSize) VoiceArray basePulseWidth {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray baseCutoff {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray damping {};
+
+    // Where the control rate modulation has ramped each voice to: a ratio of
+    // its pitch and the inverse of that, and a gain. The pulse width above and
+    // the filter coefficients below are ramped in place.
+    alignas (Vec::SIMDRegisterSize) VoiceArray pitchRatio {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray pitchInverse {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray gain {};
+
+    alignas (Vec::SIMDRegisterSize) std::array<VoiceArray, (size_t) numLfos> lfoPhase {};
+
+    // A TPT state variable low pass per voice: coefficients, then state.
+    alignas (Vec::SIMDRegisterSize) VoiceArray filterA1 {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray filterA2 {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray filterA3 {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray filterIc1 {};
+    alignas (Vec::SIMDRegisterSize) VoiceArray filterIc2 {};
+
+    std::uint64_t activeVoices = 0;
+
+    EnvelopeBank envelopes, modEnvelopes;
+    ModMatrix matrix;
+
+    juce::SharedResourcePointer<WavetableSet> wavetables;
+
+    Settings settings;
+    double sampleRate = 44100.0;
+
+    std::vector<Vec> laneMix, laneEnvelope, laneModEnvelope;
+    std::vector<float> mix;
+    std::vector<int> finishedVoices;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceBank)
+};
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    wavetable.cpp
+    Created: 18 Oct 2026 12:05:48pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "wavetable.h"
+
+namespace
+{
+    /** The amplitude of the shape's kth harmonic, as a sine at phase zero. */
+    double getHarmonic (WavetableSet::Shape shape, int k)
+    {
+        constexpr auto pi = juce::MathConstants<double>::pi;
+        auto isOdd = (k % 2) == 1;
+
+        switch (shape)
+        {
+            case WavetableSet::Shape::Sine:      return k == 1 ? 1.0 : 0.0;
+            case WavetableSet::Shape::Saw:       return (isOdd ? 2.0 : -2.0) / (pi * k);
+            case WavetableSet::Shape::Square:    return isOdd ? 4.0 / (pi * k) : 0.0;
+            case WavetableSet::Shape::Triangle:  return isOdd ? ((k % 4) == 1 ? 8.0 : -8.0) / (pi * pi * k * k) : 0.0;
+        }
+
+        return 0.0;
+    }
+}
+
+WavetableSet::WavetableSet()
+{
+    samples.resize ((size_t) (numShapes * numLevels * stride));
+
+    juce::dsp::FFT fft (tableOrder);
+    std::vector<float> data ((size_t) tableSize * 2);
+
+    for (int shape = 0; shape < numShapes; ++shape)
+    {
+        auto* shapeTables = samples.data() + shape * numLevels * stride;
+
+        for (int level = 0; level < numLevels; ++level)
+        {
+            auto numHarmonics = juce::jmin ((tableSize / 2) >> level, tableSize / 2 - 1);
+            std::fill (data.begin(), data.end(), 0.f);
+
+            // A sine of amplitude a is the bin -i a N / 2, given that the inverse
+            // transform scales by 1 / N.
+            for (int k = 1; k <= numHarmonics; ++k)
+                data[(size_t) (2 * k + 1)] = (float) (-getHarmonic ((Shape) shape, k) * tableSize * 0.5);
+
+            fft.performRealOnlyInverseTransform (data.data());
+
+            auto* table = shapeTables + level * stride;
+            std::copy_n (data.begin(), tableSize, table);
+            table[tableSize] = table[0];
+        }
+
+        // Scaled together, so that the level doesn't jump between tables.
+        auto range = juce::FloatVectorOperations::findMinAndMax (shapeTables, stride);
+        auto peak = juce::jmax (std::abs (range.getStart()), std::abs (range.getEnd()));
+        juce::FloatVectorOperations::multiply (shapeTables, 1.f / peak, numLevels * stride);
+    }
+}
+
+int WavetableSet::getTableOffset (Shape shape, float increment) const noexcept
+{
+    auto maxHarmonic = 0.5f / juce::jmax (increment, 1.0e-9f);
+    auto level = 0;
+
+    while (level < numLevels - 1 && (float) ((tableSize / 2) >> level) > maxHarmonic)
+        ++level;
+
+    return ((int) shape * numLevels + level) * stride;
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    wavetable.h
+    Created: 18 Oct 2026 12:05:48pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Band-limited single-cycle tables of the basic shapes, one per octave of
+    pitch, so that a note can always read a table with no harmonics above
+    Nyquist.
+
+    The tables are built once, from their harmonics with an inverse FFT, and
+    are shared by every voice of every instance: hold one through a
+    juce::SharedResourcePointer<WavetableSet>. Each table has a guard sample
+    past its end, so a linearly interpolated read never has to wrap.
+*/
+class WavetableSet
+{
+public:
+    enum class Shape
+    {
+        Sine,
+        Saw,
+        Square,
+        Triangle
+    };
+
+    static constexpr int numShapes = 4;
+    static constexpr int tableOrder = 11;
+    static constexpr int tableSize = 1 << tableOrder;
+
+    // Level n holds the first (tableSize / 2) >> n harmonics, down to the bare
+    // fundamental at the last level.
+    static constexpr int numLevels = tableOrder;
+
+    WavetableSet();
+
+    /** Where getSamples() has the table for shape with no harmonic above Nyquist
+        at a pitch of increment cycles per sample.
+    */
+    int getTableOffset (Shape shape, float increment) const noexcept;
+
+    const float* getSamples() const noexcept        { return samples.data(); }
+
+private:
+    static constexpr int stride = tableSize + 1;
+
+    std::vector<float> samples;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableSet)
+};
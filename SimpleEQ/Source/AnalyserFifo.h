@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    AnalyserFifo.h
+    Created: 17 Oct 2026 3:05:51pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A wait-free single-producer, single-consumer ring that hands audio from
+    processBlock to the analyser thread.
+
+    push() is the only audio thread call. It does nothing unless an analyser has
+    enabled the fifo, and otherwise only copies the first two channels into the
+    ring, dropping whatever doesn't fit. Double precision buffers are narrowed to
+    float as they are copied. All of the work, including summing to mono,
+    happens on the consumer side in pull().
+*/
+class AnalyserFifo
+{
+public:
+    static constexpr int capacity = 1 << 15;
+
+    AnalyserFifo()
+    {
+        ring.setSize (2, capacity);
+        ring.clear();
+    }
+
+    //==============================================================================
+    template <typename SampleType>
+    void push (const juce::AudioBuffer<SampleType>& buffer) noexcept
+    {
+        if (! enabled.load (std::memory_order_relaxed) || buffer.getNumChannels() == 0)
+            return;
+
+        auto numSamples = juce::jmin (buffer.getNumSamples(), fifo.getFreeSpace());
+        auto rightChannel = juce::jmin (1, buffer.getNumChannels() - 1);
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto sourceChannel = ch == 0 ? 0 : rightChannel;
+
+            auto* source = buffer.getReadPointer (sourceChannel);
+
+            copy (source, ring.getWritePointer (ch, start1), size1);
+            copy (source + size1, ring.getWritePointer (ch, start2), size2);
+        }
+
+        fifo.finishedWrite (size1 + size2);
+    }
+
+    /** Reads up to maxSamples as a mono mix into dest and returns how many were read.
+        Only call this from the one consumer thread.
+    */
+    int pull (float* dest, int maxSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (juce::jmin (maxSamples, fifo.getNumReady()), start1, size1, start2, size2);
+
+        mixToMono (dest, start1, size1);
+        mixToMono (dest + size1, start2, size2);
+
+        fifo.finishedRead (size1 + size2);
+        return size1 + size2;
+    }
+
+    /** The consumer calls this when it starts and stops listening. Anything pushed
+        while the fifo was disabled is stale, so it is thrown away on enabling.
+    */
+    void setEnabled (bool shouldBeEnabled) noexcept
+    {
+        if (shouldBeEnabled)
+            fifo.finishedRead (fifo.getNumReady());
+
+        enabled = shouldBeEnabled;
+    }
+
+private:
+    static void copy (const float* source, float* dest, int numSamples) noexcept
+    {
+        if (numSamples > 0)
+            std::memcpy (dest, source, (size_t) numSamples * sizeof (float));
+    }
+
+    /** Host buffers in double precision are narrowed on the way in. */
+    static void copy (const double* source, float* dest, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = static_cast<float> (source[i]);
+    }
+
+    void mixToMono (float* dest, int start, int numSamples) const noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        juce::FloatVectorOperations::copy (dest, ring.getReadPointer (0, start), numSamples);
+        juce::FloatVectorOperations::add (dest, ring.getReadPointer (1, start), numSamples);
+        juce::FloatVectorOperations::multiply (dest, 0.5f, numSamples);
+    }
+
+    juce::AbstractFifo fifo { capacity };
+    juce::AudioBuffer<float> ring;
+    std::atomic<bool> enabled { false };
+
+    JUCE_DECLARE_NON_COPYABLE (AnalyserFifo)
+};
@@ -0,0 +1,439 @@
+/*
+  ==============================================================================
+
+    BandDesign.h
+    Created: 17 Oct 2026 4:40:12pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CutFilter.h"
+
+/** The shapes an EQ band can take. The order matches the "BandN Type" choices. */
+enum class BandType
+{
+    Off,
+    Bell,
+    LowShelf,
+    HighShelf,
+    Notch,
+    Tilt,
+    LowCut,
+    HighCut
+};
+
+/** How a band is filtered. The order matches the "BandN Engine" choices.
+    Matched runs on the same biquads as Biquad, with designs that hold their
+    shape near Nyquist; it only differs for bells and gentle shelves.
+*/
+enum class BandEngine
+{
+    Biquad,
+    SVF,
+    Matched
+};
+
+struct BandSettings
+{
+    BandType type { BandType::Off };
+    float frequency { 1000.f }, gainInDecibels { 0.f }, quality { 1.f };
+    Slope slope { Slope::Slope_12 };
+    BandEngine engine { BandEngine::Biquad };
+};
+
+namespace BandDesign
+{
+    /** Bands 1 to 3 are the original low cut, peak and high cut. The rest are
+        fully parametric and start out switched off.
+    */
+    constexpr int maxBands = 24;
+    constexpr int numFixedBands = 3;
+
+    /** Every band gets this many biquad slots, enough for the steepest cut. */
+    constexpr int maxSectionsPerBand = Butterworth::maxSections;
+    constexpr int maxSections = maxBands * maxSectionsPerBand;
+
+    inline juce::StringArray getTypeNames()
+    {
+        return { "Off", "Bell", "Low Shelf", "High Shelf", "Notch", "Tilt", "Low Cut", "High Cut" };
+    }
+
+    inline juce::StringArray getEngineNames()
+    {
+        return { "Biquad", "SVF", "Matched" };
+    }
+
+    /** True if the band leaves the signal untouched, i.e. it is off or is a bell,
+        shelf or tilt at 0 dB. Such bands aren't processed at all.
+    */
+    inline bool isBypassed (const BandSettings& band) noexcept
+    {
+        switch (band.type)
+        {
+            case BandType::Off:        return true;
+            case BandType::Bell:
+            case BandType::LowShelf:
+            case BandType::HighShelf:
+            case BandType::Tilt:       return band.gainInDecibels == 0.f;
+            case BandType::Notch:
+            case BandType::LowCut:
+            case BandType::HighCut:    return false;
+        }
+
+        return true;
+    }
+
+    /** A first-order tilt around frequency: -gain/2 below it, +gain/2 above and
+        unity at frequency itself. Prewarped bilinear transform of
+        (sqrt(A) s + w0) / (s + sqrt(A) w0).
+    */
+    template <typename NumericType>
+    std::array<NumericType, 6> makeTilt (double sampleRate, NumericType frequency, NumericType gainFactor)
+    {
+        auto k = std::tan (juce::MathConstants<double>::pi * (double) frequency / sampleRate);
+        auto rootA = std::sqrt ((double) gainFactor);
+
+        return { static_cast<NumericType> (rootA + k), static_cast<NumericType> (k - rootA), NumericType (0),
+                 static_cast<NumericType> (1.0 + k * rootA), static_cast<NumericType> (k * rootA - 1.0), NumericType (0) };
+    }
+
+    /** How many samples the impulse response of a biquad takes to fall by
+        attenuationDecibels, going by its slowest pole.
+    */
+    template <typename NumericType>
+    double getDecayTimeInSamples (const std::array<NumericType, 6>& c, double attenuationDecibels = -120.0) noexcept
+    {
+        auto a1 = (double) c[4] / (double) c[3];
+        auto a2 = (double) c[5] / (double) c[3];
+        auto discriminant = a1 * a1 - 4.0 * a2;
+
+        // Complex poles share the radius sqrt (a2); otherwise take the larger real root.
+        auto radius = discriminant < 0.0 ? std::sqrt (a2) : 0.5 * (std::abs (a1) + std::sqrt (discriminant));
+
+        if (radius <= 0.0)
+            return 2.0;
+
+        return std::log (juce::Decibels::decibelsToGain (attenuationDecibels, attenuationDecibels - 1.0))
+                 / std::log (juce::jmin (radius, 1.0 - 1.0e-12));
+    }
+
+    //==============================================================================
+    /** Bell and shelf designs matched to their analog prototypes, after Martin
+        Vicanek's "Matched Second Order Digital Filters".
+
+        The bilinear transform squeezes the whole analog frequency axis in below
+        Nyquist, so a bell or shelf in the top octave comes out narrower and
+        lopsided. Here the prototype's poles are mapped by impulse invariance
+        instead, which keeps their frequency and damping, and the zeros are then
+        solved for so that the squared magnitude matches the prototype exactly
+        at DC, at Nyquist and at the band's frequency. The result is within a
+        fraction of a dB of the analog curve up to Nyquist without oversampling,
+        for about the same handful of transcendentals as the bilinear design.
+
+        The prototypes are RBJ's, as used by the IIR::ArrayCoefficients designs.
+        Only boosts are designed directly: each cut prototype is exactly the
+        inverse of the boost, and a high shelf is a low shelf turned upside down
+        and scaled by its gain. That keeps every designed pole at or below the
+        band's frequency, where impulse invariance is at its best.
+    */
+    namespace Matched
+    {
+        /** The analog bell boost's squared magnitude at ratio = w / w0, with A = sqrt (gain). */
+        inline double bellMagnitudeSquared (double ratio, double A, double quality) noexcept
+        {
+            auto x = 1.0 - ratio * ratio;
+            auto numerator = A * ratio / quality, denominator = ratio / (A * quality);
+
+            return (x * x + numerator * numerator) / (x * x + denominator * denominator);
+        }
+
+        /** The analog low shelf boost's squared magnitude at ratio = w / w0, with A = sqrt (gain). */
+        inline double lowShelfMagnitudeSquared (double ratio, double A, double quality) noexcept
+        {
+            auto r2 = ratio * ratio;
+            auto damping = A * r2 / (quality * quality);
+
+            return A * A * ((A - r2) * (A - r2) + damping) / ((1.0 - A * r2) * (1.0 - A * r2) + damping);
+        }
+
+        /** Designs the biquad whose poles are those of s^2 + 2 zeta wp s + wp^2,
+            with wp = poleRatio * w0, and whose squared magnitude matches
+            magnitudeSquared (w / w0) at DC, Nyquist and w0. w0 is in radians per
+            sample.
+        */
+        template <typename MagnitudeSquared>
+        std::array<double, 6> design (double w0, double zeta, double poleRatio, MagnitudeSquared&& magnitudeSquared)
+        {
+            auto wp = poleRatio * w0;
+            auto radius = std::exp (-zeta * wp);
+            auto a1 = -2.0 * radius * (zeta <= 1.0 ? std::cos (std::sqrt (1.0 - zeta * zeta) * wp)
+                                                   : std::cosh (std::sqrt (zeta * zeta - 1.0) * wp));
+            auto a2 = radius * radius;
+
+            // With phi1 = sin^2 (w / 2), phi0 = 1 - phi1 and phi2 = 4 phi0 phi1, a biquad's
+            // squared magnitude is (B0 phi0 + B1 phi1 + B2 phi2) / (A0 phi0 + A1 phi1 + A2 phi2).
+            auto A0 = (1.0 + a1 + a2) * (1.0 + a1 + a2);
+            auto A1 = (1.0 - a1 + a2) * (1.0 - a1 + a2);
+            auto A2 = -4.0 * a2;
+
+            auto sinHalf = std::sin (0.5 * w0);
+            auto phi1 = sinHalf * sinHalf, phi0 = 1.0 - phi1, phi2 = 4.0 * phi0 * phi1;
+
+            auto B0 = A0 * magnitudeSquared (0.0);
+            auto B1 = A1 * magnitudeSquared (juce::MathConstants<double>::pi / w0);
+            auto B2 = (magnitudeSquared (1.0) * (A0 * phi0 + A1 * phi1 + A2 * phi2) - B0 * phi0 - B1 * phi1) / phi2;
+
+            // Factor back into the minimum phase numerator.
+            auto root0 = std::sqrt (B0), root1 = std::sqrt (B1);
+            auto w = 0.5 * (root0 + root1);
+            auto b0 = 0.5 * (w + std::sqrt (juce::jmax (0.0, w * w + B2)));
+
+            return { b0, 0.5 * (root0 - root1), -B2 / (4.0 * b0), 1.0, a1, a2 };
+        }
+
+        /** Swaps the numerator and denominator, normalised so that a0 stays 1. */
+        inline std::array<double, 6> invert (const std::array<double, 6>& c) noexcept
+        {
+            return { c[3] / c[0], c[4] / c[0], c[5] / c[0], 1.0, c[1] / c[0], c[2] / c[0] };
+        }
+
+        /** Above this quality a shelf has a bump and a dip on either side of its
+            frequency, which three matching points can't place; the bilinear design
+            gets closer there, so such shelves keep it.
+        */
+        constexpr float maxShelfQuality = 1.f;
+
+        inline bool isUsedFor (const BandSettings& band) noexcept
+        {
+            return band.engine == BandEngine::Matched
+                && (band.type == BandType::Bell
+                     || ((band.type == BandType::LowShelf || band.type == BandType::HighShelf) && band.quality <= maxShelfQuality));
+        }
+    }
+
+    /** A matched bell, low shelf or high shelf; see BandDesign::Matched. */
+    template <typename NumericType>
+    std::array<NumericType, 6> makeMatched (BandType type, double sampleRate, double frequency, double quality, double gainInDecibels)
+    {
+        jassert (type == BandType::Bell || type == BandType::LowShelf || type == BandType::HighShelf);
+
+        auto w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        auto A = std::pow (10.0, std::abs (gainInDecibels) / 40.0);
+
+        auto c = type == BandType::Bell
+                   ? Matched::design (w0, 0.5 / (A * quality), 1.0,
+                                      [A, quality] (double ratio) { return Matched::bellMagnitudeSquared (ratio, A, quality); })
+                   : Matched::design (w0, 0.5 / quality, 1.0 / std::sqrt (A),
+                                      [A, quality] (double ratio) { return Matched::lowShelfMagnitudeSquared (ratio, A, quality); });
+
+        // A high shelf boost is the inverse of the low shelf boost times the full gain,
+        // and a high shelf cut the low shelf boost divided by it.
+        if ((gainInDecibels < 0.0) != (type == BandType::HighShelf))
+            c = Matched::invert (c);
+
+        auto scale = type == BandType::HighShelf ? juce::Decibels::decibelsToGain (gainInDecibels) : 1.0;
+
+        return { static_cast<NumericType> (c[0] * scale), static_cast<NumericType> (c[1] * scale), static_cast<NumericType> (c[2] * scale),
+                 static_cast<NumericType> (c[3]), static_cast<NumericType> (c[4]), static_cast<NumericType> (c[5]) };
+    }
+
+    template <typename NumericType>
+    using SectionCoefficients = std::array<std::array<NumericType, 6>, maxSectionsPerBand>;
+
+    /** Designs the biquads for band at sampleRate into sections and returns how many
+        of them are used. Returns 0 for bypassed bands.
+    */
+    template <typename NumericType>
+    int makeSections (const BandSettings& band, double sampleRate, SectionCoefficients<NumericType>& sections)
+    {
+        using Coefficients = juce::dsp::IIR::ArrayCoefficients<NumericType>;
+
+        if (isBypassed (band))
+            return 0;
+
+        // Keep the design below Nyquist when the band is set higher than the rate allows.
+        auto frequency = static_cast<NumericType> (juce::jmin ((double) band.frequency, sampleRate * 0.49));
+        auto quality = static_cast<NumericType> (band.quality);
+        auto gainFactor = static_cast<NumericType> (juce::Decibels::decibelsToGain (band.gainInDecibels));
+
+        if (Matched::isUsedFor (band))
+        {
+            sections[0] = makeMatched<NumericType> (band.type, sampleRate, (double) frequency, (double) band.quality, (double) band.gainInDecibels);
+            return 1;
+        }
+
+        switch (band.type)
+        {
+            case BandType::Bell:      sections[0] = Coefficients::makePeakFilter (sampleRate, frequency, quality, gainFactor); return 1;
+            case BandType::LowShelf:  sections[0] = Coefficients::makeLowShelf (sampleRate, frequency, quality, gainFactor); return 1;
+            case BandType::HighShelf: sections[0] = Coefficients::makeHighShelf (sampleRate, frequency, quality, gainFactor); return 1;
+            case BandType::Notch:     sections[0] = Coefficients::makeNotch (sampleRate, frequency, quality); return 1;
+            case BandType::Tilt:      sections[0] = makeTilt (sampleRate, frequency, gainFactor); return 1;
+
+            case BandType::LowCut:
+                sections = Butterworth::makeHighPass (sampleRate, frequency, band.slope);
+                return Butterworth::getNumSections (band.slope);
+
+            case BandType::HighCut:
+                sections = Butterworth::makeLowPass (sampleRate, frequency, band.slope);
+                return Butterworth::getNumSections (band.slope);
+
+            case BandType::Off:
+                break;
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    /** One stage of a TPT state variable filter: prewarped cutoff g, damping k and
+        the output mix m0 * input + m1 * band + m2 * low.
+    */
+    template <typename NumericType>
+    struct SVFCoefficients
+    {
+        NumericType g, k, m0, m1, m2;
+    };
+
+    template <typename NumericType>
+    using SVFStageCoefficients = std::array<SVFCoefficients<NumericType>, maxSectionsPerBand>;
+
+    /** Designs band as up to maxSectionsPerBand SVF stages and returns how many are
+        used. The bell, shelves, notch and cuts have the same responses as their
+        makeSections() counterparts; the tilt is a gentle second-order shelf pair
+        rather than a first-order one.
+    */
+    template <typename NumericType>
+    int makeSVFStages (const BandSettings& band, double sampleRate, SVFStageCoefficients<NumericType>& stages)
+    {
+        if (isBypassed (band))
+            return 0;
+
+        auto frequency = juce::jmin ((double) band.frequency, sampleRate * 0.49);
+        auto g = std::tan (juce::MathConstants<double>::pi * frequency / sampleRate);
+        auto k = 1.0 / (double) band.quality;
+        auto a = std::pow (10.0, (double) band.gainInDecibels / 40.0);
+
+        auto set = [&stages] (size_t stage, double stageG, double stageK, double m0, double m1, double m2)
+        {
+            stages[stage] = { static_cast<NumericType> (stageG), static_cast<NumericType> (stageK),
+                              static_cast<NumericType> (m0), static_cast<NumericType> (m1), static_cast<NumericType> (m2) };
+        };
+
+        switch (band.type)
+        {
+            case BandType::Bell:      k /= a; set (0, g, k, 1.0, k * (a * a - 1.0), 0.0); return 1;
+            case BandType::LowShelf:  set (0, g / std::sqrt (a), k, 1.0, k * (a - 1.0), a * a - 1.0); return 1;
+            case BandType::HighShelf: set (0, g * std::sqrt (a), k, a * a, k * (1.0 - a) * a, 1.0 - a * a); return 1;
+            case BandType::Notch:     set (0, g, k, 1.0, -k, 0.0); return 1;
+
+            case BandType::Tilt:
+            {
+                // A Butterworth-damped high shelf of the full gain, scaled down by
+                // half of it so that the centre stays at unity.
+                auto tiltK = juce::MathConstants<double>::sqrt2;
+                set (0, g * std::sqrt (a), tiltK, a, tiltK * (1.0 - a), (1.0 - a * a) / a);
+                return 1;
+            }
+
+            case BandType::LowCut:
+            case BandType::HighCut:
+            {
+                auto numStages = Butterworth::getNumSections (band.slope);
+
+                for (int i = 0; i < numStages; ++i)
+                {
+                    auto stageK = 1.0 / Butterworth::sectionQs[(size_t) band.slope][(size_t) i];
+
+                    if (band.type == BandType::LowCut)
+                        set ((size_t) i, g, stageK, 1.0, -stageK, -1.0);
+                    else
+                        set ((size_t) i, g, stageK, 0.0, 0.0, 1.0);
+                }
+
+                return numStages;
+            }
+
+            case BandType::Off:
+                break;
+        }
+
+        return 0;
+    }
+
+    /** Moves a bell stage from makeSVFStages to a new gain. Only k and the mix
+        depend on the gain, so g, and the tan behind it, are kept.
+    */
+    template <typename NumericType>
+    void setSVFBellGain (SVFCoefficients<NumericType>& stage, float quality, float gainInDecibels)
+    {
+        auto a = std::pow (10.0, (double) gainInDecibels / 40.0);
+        auto k = 1.0 / ((double) quality * a);
+
+        stage.k = static_cast<NumericType> (k);
+        stage.m1 = static_cast<NumericType> (k * (a * a - 1.0));
+    }
+
+    /** The biquad with the same response as an SVF stage, in the
+        { b0, b1, b2, a0, a1, a2 } order of IIR::ArrayCoefficients.
+
+        The stage is m0 + (m1 s + m2) / (s^2 + k s + 1) in the prewarped s-plane,
+        which the bilinear transform s = (1 / g) (1 - z^-1) / (1 + z^-1) maps here.
+    */
+    template <typename NumericType>
+    std::array<NumericType, 6> toArrayCoefficients (const SVFCoefficients<NumericType>& c)
+    {
+        auto g = (double) c.g, k = (double) c.k;
+        auto n2 = (double) c.m0, n1 = (double) c.m0 * k + (double) c.m1, n0 = (double) c.m0 + (double) c.m2;
+
+        auto map = [g] (double p2, double p1, double p0)
+        {
+            return std::array<double, 3> { p2 + p1 * g + p0 * g * g, 2.0 * (p0 * g * g - p2), p2 - p1 * g + p0 * g * g };
+        };
+
+        auto b = map (n2, n1, n0);
+        auto a = map (1.0, k, 1.0);
+
+        return { static_cast<NumericType> (b[0]), static_cast<NumericType> (b[1]), static_cast<NumericType> (b[2]),
+                 static_cast<NumericType> (a[0]), static_cast<NumericType> (a[1]), static_cast<NumericType> (a[2]) };
+    }
+}
+
+/** What drives a dynamic band's gain. The order matches the "Peak Dynamics" choices. */
+enum class DynamicsMode
+{
+    Off,
+    Band,
+    Sidechain
+};
+
+/** Level-dependent gain for a bell band. Once the detected level passes the
+    threshold, the gain moves by (level - threshold) * (1 - 1 / ratio) dB in the
+    direction of range, and by no more than range.
+*/
+struct DynamicSettings
+{
+    DynamicsMode mode { DynamicsMode::Off };
+    float thresholdInDecibels { -24.f }, ratio { 2.f }, rangeInDecibels { -12.f };
+    float attackInMilliseconds { 10.f }, releaseInMilliseconds { 150.f };
+};
+
+struct ChainSettings
+{
+    // The first BandDesign::numFixedBands bands come from the original parameters.
+    enum FixedBands
+    {
+        LowCut,
+        Peak,
+        HighCut
+    };
+
+    std::array<BandSettings, BandDesign::maxBands> bands;
+
+    // Applies to the Peak band.
+    DynamicSettings dynamics;
+};
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    BiquadBank.h
+    Created: 17 Oct 2026 4:58:44pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A fixed-capacity bank of transposed direct form II biquads, stored as a
+    structure of arrays.
+
+    Each slot has its own coefficients and state. Only the slots in the active
+    list are processed, in list order, each one as a single in-place pass over
+    the block with its coefficients and state held in registers. Slots that are
+    not in the list are never touched, so an unused band costs nothing.
+
+    SampleType may be a plain float/double or a juce::dsp::SIMDRegister. In the
+    SIMD case every lane is an independent channel with its own state, so one
+    pass over an interleaved block filters SampleType::size() channels at once.
+    Coefficients are stored per lane as well, which lets different lanes run
+    different settings at no extra cost.
+*/
+template <typename SampleType, size_t MaxSections>
+class BiquadBank
+{
+public:
+    using NumericType = typename juce::dsp::SampleTypeHelpers::ElementType<SampleType>::Type;
+
+    /** Raw coefficients in the order used by IIR::ArrayCoefficients,
+        i.e. { b0, b1, b2, a0, a1, a2 }.
+    */
+    using ArrayCoefficients = std::array<NumericType, 6>;
+
+    //==============================================================================
+    void prepare (const juce::dsp::ProcessSpec&) noexcept    { reset(); }
+
+    void reset() noexcept
+    {
+        s1.fill (broadcast (0));
+        s2.fill (broadcast (0));
+    }
+
+    /** Sets the same coefficients on every lane of a slot. */
+    void setCoefficients (size_t slot, const ArrayCoefficients& c) noexcept
+    {
+        jassert (slot < MaxSections);
+
+        auto a0Inv = static_cast<NumericType> (1) / c[3];
+
+        b0[slot] = broadcast (c[0] * a0Inv);
+        b1[slot] = broadcast (c[1] * a0Inv);
+        b2[slot] = broadcast (c[2] * a0Inv);
+        a1[slot] = broadcast (c[4] * a0Inv);
+        a2[slot] = broadcast (c[5] * a0Inv);
+    }
+
+    /** Sets the coefficients of one lane of a slot, leaving the others alone. */
+    void setLaneCoefficients (size_t slot, size_t lane, const ArrayCoefficients& c) noexcept
+    {
+        jassert (slot < MaxSections);
+
+        auto a0Inv = static_cast<NumericType> (1) / c[3];
+
+        setLane (b0[slot], lane, c[0] * a0Inv);
+        setLane (b1[slot], lane, c[1] * a0Inv);
+        setLane (b2[slot], lane, c[2] * a0Inv);
+        setLane (a1[slot], lane, c[4] * a0Inv);
+        setLane (a2[slot], lane, c[5] * a0Inv);
+    }
+
+    /** Replaces the list of slots to run. Slots joining the list are cleared first,
+        as they still hold whatever they last rang with.
+    */
+    void setActiveSlots (const uint16_t* slots, size_t numSlots) noexcept
+    {
+        jassert (numSlots <= MaxSections);
+
+        std::array<bool, MaxSections> wasActive {};
+
+        for (size_t i = 0; i < numActive; ++i)
+            wasActive[activeSlots[i]] = true;
+
+        for (size_t i = 0; i < numSlots; ++i)
+        {
+            if (! wasActive[slots[i]])
+            {
+                s1[slots[i]] = broadcast (0);
+                s2[slots[i]] = broadcast (0);
+            }
+
+            activeSlots[i] = slots[i];
+        }
+
+        numActive = numSlots;
+    }
+
+    size_t getNumActiveSlots() const noexcept    { return numActive; }
+
+    /** True if the state of every active slot, on every lane, is within threshold
+        of zero, i.e. anything the bank was ringing with has died away.
+    */
+    bool isStateBelow (NumericType threshold) const noexcept
+    {
+        auto largest = broadcast (0);
+
+        for (size_t i = 0; i < numActive; ++i)
+            largest = max (largest, max (abs (s1[activeSlots[i]]), abs (s2[activeSlots[i]])));
+
+        if constexpr (std::is_floating_point<SampleType>::value)
+        {
+            return largest <= threshold;
+        }
+        else
+        {
+            for (size_t lane = 0; lane < SampleType::size(); ++lane)
+                if (largest.get (lane) > threshold)
+                    return false;
+
+            return true;
+        }
+    }
+
+    //==============================================================================
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                       "The sample type of the context must match the sample type of the filter");
+
+        auto&& outputBlock = context.getOutputBlock();
+
+        // The sections run one after the other in place on the output block.
+        jassert (! context.usesSeparateInputAndOutputBlocks());
+        jassert (outputBlock.getNumChannels() == 1);
+
+        if (context.isBypassed)
+            return;
+
+        processSamples (outputBlock.getChannelPointer (0), outputBlock.getNumSamples());
+    }
+
+    void processSamples (SampleType* data, size_t numSamples) noexcept
+    {
+        for (size_t i = 0; i < numActive; ++i)
+            processSlot (activeSlots[i], data, numSamples);
+    }
+
+private:
+    void processSlot (size_t slot, SampleType* data, size_t numSamples) noexcept
+    {
+        auto lb0 = b0[slot], lb1 = b1[slot], lb2 = b2[slot], la1 = a1[slot], la2 = a2[slot];
+        auto ls1 = s1[slot], ls2 = s2[slot];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto in  = data[i];
+            auto out = in * lb0 + ls1;
+
+            ls1 = in * lb1 - out * la1 + ls2;
+            ls2 = in * lb2 - out * la2;
+
+            data[i] = out;
+        }
+
+        s1[slot] = ls1;
+        s2[slot] = ls2;
+    }
+
+    static SampleType abs (SampleType x) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+            return std::abs (x);
+        else
+            return SampleType::abs (x);
+    }
+
+    static SampleType max (SampleType a, SampleType b) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+            return juce::jmax (a, b);
+        else
+            return SampleType::max (a, b);
+    }
+
+    static void setLane (SampleType& target, size_t lane, NumericType value) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+        {
+            jassertquiet (lane == 0);
+            target = value;
+        }
+        else
+        {
+            target.set (lane, value);
+        }
+    }
+
+    static SampleType broadcast (NumericType value) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+            return value;
+        else
+            return SampleType::expand (value);
+    }
+
+    using Column = std::array<SampleType, MaxSections>;
+
+    Column b0, b1, b2, a1, a2, s1, s2;
+    std::array<uint16_t, MaxSections> activeSlots {};
+    size_t numActive = 0;
+};
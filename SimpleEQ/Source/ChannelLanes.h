@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    ChannelLanes.h
+    Created: 17 Oct 2026 11:20:48am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Helpers for moving audio between a regular non-interleaved block and a
+    single-channel block of SIMD registers, where each lane of the register
+    carries one channel.
+*/
+namespace ChannelLanes
+{
+    template <typename SIMDType>
+    constexpr size_t numLanes = SIMDType::size();
+
+    /** Copies up to numLanes channels, starting at firstChannel, into the lanes of
+        dest. Lanes with no matching source channel are zeroed.
+    */
+    template <typename SIMDType>
+    void interleave (const juce::dsp::AudioBlock<typename SIMDType::ElementType>& source, size_t firstChannel,
+                     juce::dsp::AudioBlock<SIMDType>& dest) noexcept
+    {
+        using ElementType = typename SIMDType::ElementType;
+        constexpr auto lanes = numLanes<SIMDType>;
+
+        jassert (dest.getNumChannels() == 1 && dest.getNumSamples() == source.getNumSamples());
+
+        auto numSamples = source.getNumSamples();
+        auto* dst = reinterpret_cast<ElementType*> (dest.getChannelPointer (0));
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto channel = firstChannel + lane;
+
+            if (channel < source.getNumChannels())
+            {
+                auto* src = source.getChannelPointer (channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    dst[i * lanes + lane] = src[i];
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    dst[i * lanes + lane] = ElementType (0);
+            }
+        }
+    }
+
+    /** The inverse of interleave(): writes the lanes of source back to the
+        channels of dest that start at firstChannel. Lanes past the last channel
+        are dropped.
+    */
+    template <typename SIMDType>
+    void deinterleave (const juce::dsp::AudioBlock<SIMDType>& source,
+                       juce::dsp::AudioBlock<typename SIMDType::ElementType>& dest, size_t firstChannel) noexcept
+    {
+        using ElementType = typename SIMDType::ElementType;
+        constexpr auto lanes = numLanes<SIMDType>;
+
+        jassert (source.getNumChannels() == 1 && dest.getNumSamples() == source.getNumSamples());
+
+        auto numSamples = dest.getNumSamples();
+        auto* src = reinterpret_cast<const ElementType*> (source.getChannelPointer (0));
+
+        for (size_t lane = 0; lane < lanes && firstChannel + lane < dest.getNumChannels(); ++lane)
+        {
+            auto* dst = dest.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = src[i * lanes + lane];
+        }
+    }
+
+    /** Like interleave() for the first two channels of source, but encodes them
+        as mid in lane 0 and side in lane 1 on the way in. The other lanes are
+        zeroed.
+    */
+    template <typename SIMDType>
+    void interleaveMidSide (const juce::dsp::AudioBlock<typename SIMDType::ElementType>& source,
+                            juce::dsp::AudioBlock<SIMDType>& dest) noexcept
+    {
+        using ElementType = typename SIMDType::ElementType;
+        constexpr auto lanes = numLanes<SIMDType>;
+        static_assert (lanes >= 2, "Mid/side needs a register with at least two lanes");
+
+        jassert (source.getNumChannels() >= 2 && dest.getNumChannels() == 1 && dest.getNumSamples() == source.getNumSamples());
+
+        auto numSamples = source.getNumSamples();
+        auto* left = source.getChannelPointer (0);
+        auto* right = source.getChannelPointer (1);
+        auto* dst = reinterpret_cast<ElementType*> (dest.getChannelPointer (0));
+        const auto half = static_cast<ElementType> (0.5);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            dst[i * lanes] = half * (left[i] + right[i]);
+            dst[i * lanes + 1] = half * (left[i] - right[i]);
+
+            for (size_t lane = 2; lane < lanes; ++lane)
+                dst[i * lanes + lane] = ElementType (0);
+        }
+    }
+
+    /** The inverse of interleaveMidSide(): decodes lanes 0 and 1 back to left and
+        right as they are written to the first two channels of dest.
+    */
+    template <typename SIMDType>
+    void deinterleaveMidSide (const juce::dsp::AudioBlock<SIMDType>& source,
+                              juce::dsp::AudioBlock<typename SIMDType::ElementType>& dest) noexcept
+    {
+        using ElementType = typename SIMDType::ElementType;
+        constexpr auto lanes = numLanes<SIMDType>;
+
+        jassert (source.getNumChannels() == 1 && dest.getNumChannels() >= 2 && dest.getNumSamples() == source.getNumSamples());
+
+        auto numSamples = dest.getNumSamples();
+        auto* src = reinterpret_cast<const ElementType*> (source.getChannelPointer (0));
+        auto* left = dest.getChannelPointer (0);
+        auto* right = dest.getChannelPointer (1);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto mid = src[i * lanes], side = src[i * lanes + 1];
+            left[i] = mid + side;
+            right[i] = mid - side;
+        }
+    }
+}
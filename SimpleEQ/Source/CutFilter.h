@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    CutFilter.h
+    Created: 17 Oct 2026 10:12:40am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+namespace Butterworth
+{
+    constexpr int maxSections = 4;
+
+    /** Qs of the 2nd-order sections making up an order 2 * (slope + 1) Butterworth
+        filter, indexed by [slope][section]. Each one is 1 / (2 cos (theta_k)) with
+        theta_k = (2k - 1) * pi / (2 * order), listed in ascending order so the
+        high-Q section runs last.
+    */
+    constexpr std::array<std::array<double, maxSections>, maxSections> sectionQs
+    {{
+        { 0.70710678118654752, 0.0,                 0.0,                 0.0                },
+        { 0.54119610014619699, 1.30656296487637653, 0.0,                 0.0                },
+        { 0.51763809020504152, 0.70710678118654752, 1.93185165257813657, 0.0                },
+        { 0.50979557910415917, 0.60134488693504528, 0.89997622313641570, 2.56291544774150618 }
+    }};
+
+    constexpr int getNumSections (Slope slope) noexcept    { return static_cast<int> (slope) + 1; }
+
+    /** Coefficients for every section of a high- or low-pass cascade. Only the
+        first getNumSections (slope) entries are meaningful.
+    */
+    template <typename NumericType>
+    using CascadeCoefficients = std::array<std::array<NumericType, 6>, maxSections>;
+
+    template <typename NumericType>
+    CascadeCoefficients<NumericType> makeHighPass (double sampleRate, NumericType frequency, Slope slope)
+    {
+        CascadeCoefficients<NumericType> result {};
+
+        for (int i = 0; i < getNumSections (slope); ++i)
+            result[(size_t) i] = juce::dsp::IIR::ArrayCoefficients<NumericType>::makeHighPass (sampleRate, frequency,
+                                                                                               static_cast<NumericType> (sectionQs[(size_t) slope][(size_t) i]));
+
+        return result;
+    }
+
+    template <typename NumericType>
+    CascadeCoefficients<NumericType> makeLowPass (double sampleRate, NumericType frequency, Slope slope)
+    {
+        CascadeCoefficients<NumericType> result {};
+
+        for (int i = 0; i < getNumSections (slope); ++i)
+            result[(size_t) i] = juce::dsp::IIR::ArrayCoefficients<NumericType>::makeLowPass (sampleRate, frequency,
+                                                                                              static_cast<NumericType> (sectionQs[(size_t) slope][(size_t) i]));
+
+        return result;
+    }
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    DynamicGain.h
+    Created: 17 Oct 2026 8:52:07pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BandDesign.h"
+
+//==============================================================================
+/**
+    The level detector behind a dynamic band.
+
+    Each channel of the detector signal goes through a unity-peak TPT band-pass
+    tuned to the band, is rectified, and the loudest channel drives one
+    attack/release peak follower, so every channel gets the same gain. Only the
+    follower runs per sample; the gain itself is worked out from it on the
+    chain's control grid, which keeps the log and the band redesign down to one
+    per grid step.
+*/
+template <typename SampleType>
+class DynamicGain
+{
+public:
+    /** Allocates the detector state for numChannels channels. */
+    void prepare (double newSampleRate, size_t numChannels)
+    {
+        sampleRate = newSampleRate;
+        ic1.assign (numChannels, SampleType (0));
+        ic2.assign (numChannels, SampleType (0));
+        setSettings (settings);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::fill (ic1.begin(), ic1.end(), SampleType (0));
+        std::fill (ic2.begin(), ic2.end(), SampleType (0));
+        envelope = SampleType (0);
+    }
+
+    void setSettings (const DynamicSettings& newSettings) noexcept
+    {
+        settings = newSettings;
+
+        auto coefficientFor = [this] (float milliseconds)
+        {
+            return (SampleType) std::exp (-1.0 / (juce::jmax (0.01, (double) milliseconds) * 0.001 * sampleRate));
+        };
+
+        attack = coefficientFor (settings.attackInMilliseconds);
+        release = coefficientFor (settings.releaseInMilliseconds);
+    }
+
+    /** Tunes the detector's band-pass to the band, at the rate the detector runs. */
+    void setDetectorBand (float frequency, float quality) noexcept
+    {
+        auto g = std::tan (juce::MathConstants<double>::pi * juce::jmin ((double) frequency, sampleRate * 0.49) / sampleRate);
+        auto k = 1.0 / (double) quality;
+
+        a1 = (SampleType) (1.0 / (1.0 + g * (g + k)));
+        a2 = (SampleType) g * a1;
+        a3 = (SampleType) g * a2;
+        bandGain = (SampleType) k;
+    }
+
+    /** Follows the level of source, one channel per detector channel. */
+    void process (const juce::dsp::AudioBlock<const SampleType>& source) noexcept
+    {
+        auto numChannels = juce::jmin (source.getNumChannels(), ic1.size());
+
+        for (size_t i = 0; i < source.getNumSamples(); ++i)
+        {
+            auto level = SampleType (0);
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                auto v3 = source.getChannelPointer (ch)[i] - ic2[ch];
+                auto v1 = a1 * ic1[ch] + a2 * v3;
+                auto v2 = ic2[ch] + a2 * ic1[ch] + a3 * v3;
+
+                ic1[ch] = v1 + v1 - ic1[ch];
+                ic2[ch] = v2 + v2 - ic2[ch];
+
+                level = juce::jmax (level, std::abs (bandGain * v1));
+            }
+
+            auto coefficient = level > envelope ? attack : release;
+            envelope = level + coefficient * (envelope - level);
+        }
+    }
+
+    /** How far the band's gain should move from its static setting right now. */
+    float getGainOffsetInDecibels() const noexcept
+    {
+        if (settings.mode == DynamicsMode::Off)
+            return 0.f;
+
+        auto over = juce::Decibels::gainToDecibels ((float) envelope, -200.f) - settings.thresholdInDecibels;
+
+        if (over <= 0.f)
+            return 0.f;
+
+        auto offset = juce::jmin (over * (1.f - 1.f / settings.ratio), std::abs (settings.rangeInDecibels));
+        return settings.rangeInDecibels < 0.f ? -offset : offset;
+    }
+
+private:
+    DynamicSettings settings;
+    double sampleRate = 44100.0;
+
+    SampleType a1 {}, a2 {}, a3 {}, bandGain {};
+    SampleType attack {}, release {}, envelope {};
+    std::vector<SampleType> ic1, ic2;
+};
@@ -0,0 +1,778 @@
+/*
+  ==============================================================================
+
+    EQChain.h
+    Created: 17 Oct 2026 5:36:19pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BandDesign.h"
+#include "BiquadBank.h"
+#include "SVFBank.h"
+#include "ChannelLanes.h"
+#include "DynamicGain.h"
+
+enum OversamplingFilter
+{
+    IIRHalfBand,
+    FIRLinearPhase
+};
+
+/** How a stereo bus is split between the two parameter sets. The order matches
+    the "Channel Mode" choices.
+*/
+enum class ChannelMode
+{
+    Stereo,     // both channels use the first set
+    MidSide,    // mid uses the first set, side the second
+    DualMono    // left uses the first set, right the second
+};
+
+//==============================================================================
+/**
+    The minimum phase EQ for one sample type: optional oversampling around a
+    biquad bank and an SVF bank per group of SIMD lanes. Each band runs in
+    whichever of the two its engine setting picks.
+
+    SampleType is float or double. With double, coefficients are designed and
+    filters run in double precision end to end, which keeps low bands at high
+    sample rates clean. The host's buffers are processed in place either way.
+
+    New band settings are only picked up on a fixed grid of controlInterval
+    samples that runs across host blocks. From there, frequency, gain and Q
+    glide to their targets one grid step at a time, and only the bands still
+    moving are redesigned. The output therefore doesn't depend on how the host
+    slices its buffers, and the redesign cost is bounded by the grid rate.
+    Biquad bands step to their new coefficients at each grid point, while SVF
+    bands ramp theirs sample by sample across the grid interval, so they can be
+    swept quickly without zipper noise.
+
+    When dynamics are on, the Peak band always runs as an SVF, and its gain is
+    moved from its static setting by a DynamicGain at every grid point,
+    listening either to the band's own input or to a sidechain.
+
+    A stereo bus can also run in mid/side or dual mono, each side with its own
+    set of bands. Both channels still share one SIMD register, so the second set
+    only changes which coefficients lane 1 holds, and mid/side is encoded and
+    decoded as the lanes are interleaved. Neither mode touches the audio any
+    more often than plain stereo does.
+
+    Each group of lanes goes to sleep once its input has been silent for longer
+    than the oversampling latency and its filter state has decayed below
+    silenceThresholdDecibels. A sleeping group is skipped entirely until sound
+    comes back, and when every group is asleep so is the oversampler.
+*/
+template <typename SampleType>
+class EQChain
+{
+public:
+    using SIMDType = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int maxOversamplingOrder = 3;
+    static constexpr size_t controlInterval = 32;
+    static constexpr double smoothingTimeSeconds = 0.05;
+    static constexpr double silenceThresholdDecibels = -120.0;
+    static constexpr size_t maxParameterSets = 2;
+
+    //==============================================================================
+    /** Allocates everything, including every oversampling factor of both filter
+        types, so that nothing is allocated once processing starts.
+    */
+    void prepare (double newSampleRate, size_t newMaxBlockSize, size_t numChannels)
+    {
+        sampleRate = newSampleRate;
+        maxBlockSize = newMaxBlockSize;
+        numChannelsPrepared = numChannels;
+
+        juce::dsp::ProcessSpec spec;
+        spec.sampleRate = sampleRate;
+        spec.maximumBlockSize = (juce::uint32) (maxBlockSize << maxOversamplingOrder);
+        spec.numChannels = 1;
+
+        constexpr auto lanes = ChannelLanes::numLanes<SIMDType>;
+        chains.resize ((numChannels + lanes - 1) / lanes);
+        groups.resize (chains.size());
+
+        for (auto& chain : chains)
+            chain.prepare (spec);
+
+        interleaved = juce::dsp::AudioBlock<SIMDType> (interleavedBlockData, 1, spec.maximumBlockSize);
+
+        for (int filter = 0; filter < (int) oversamplers.size(); ++filter)
+        {
+            auto filterType = filter == OversamplingFilter::IIRHalfBand ? Oversampling::filterHalfBandPolyphaseIIR
+                                                                        : Oversampling::filterHalfBandFIREquiripple;
+
+            for (int order = 1; order <= maxOversamplingOrder; ++order)
+            {
+                auto& os = oversamplers[(size_t) filter][(size_t) order - 1];
+                os = std::make_unique<Oversampling> (numChannels, (size_t) order, filterType, true, true);
+                os->initProcessing (maxBlockSize);
+            }
+        }
+
+        dynamics.prepare (sampleRate, numChannels);
+
+        for (auto& set : smoothedBands)
+        {
+            for (auto& band : set)
+            {
+                band.frequency.reset (sampleRate / (double) controlInterval, smoothingTimeSeconds);
+                band.gain.reset (sampleRate / (double) controlInterval, smoothingTimeSeconds);
+                band.quality.reset (sampleRate / (double) controlInterval, smoothingTimeSeconds);
+            }
+        }
+
+        oversampler = nullptr;
+        oversamplingOrder = 0;
+        setChannelMode (requestedChannelMode);
+    }
+
+    /** Frees what prepare() allocated. */
+    void release()
+    {
+        chains = {};
+        groups = {};
+        interleavedBlockData.free();
+        interleaved = {};
+
+        for (auto& filter : oversamplers)
+            for (auto& os : filter)
+                os.reset();
+
+        oversampler = nullptr;
+    }
+
+    /** Clears the filters and restarts the control grid. The next grid point jumps
+        straight to the latest settings instead of gliding to them.
+    */
+    void reset() noexcept
+    {
+        for (auto& chain : chains)
+            chain.reset();
+
+        if (oversampler != nullptr)
+            oversampler->reset();
+
+        for (auto& group : groups)
+            group = {};
+
+        dynamics.reset();
+        samplesUntilNextControlPoint = 0;
+        snapToTargets = true;
+    }
+
+    /** Switches to 2^order times oversampling, or none for order 0, and starts the
+        filters again from silence. Only swaps a pointer, so it is safe on the
+        audio thread.
+    */
+    void setOversampling (int order, int filter) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (order, maxOversamplingOrder + 1));
+
+        oversamplingOrder = order;
+        oversampler = order > 0 && chains.size() > 0 ? oversamplers[(size_t) filter][(size_t) order - 1].get() : nullptr;
+
+        // The coefficients were designed for the old rate, so redesign everything
+        // at the next grid point.
+        reset();
+        hasNewTargets = true;
+    }
+
+    /** Switches how the channels are split between the parameter sets. The split
+        modes need exactly two channels; anything else runs as plain stereo.
+    */
+    void setChannelMode (ChannelMode newMode) noexcept
+    {
+        requestedChannelMode = newMode;
+        channelMode = numChannelsPrepared == 2 ? newMode : ChannelMode::Stereo;
+        numSets = channelMode == ChannelMode::Stereo ? 1 : maxParameterSets;
+
+        // Both lanes were designed for the old split, so redesign everything.
+        reset();
+        hasNewTargets = true;
+    }
+
+    /** The oversamplers are built with integer latency, so this is exact. */
+    int getLatencyInSamples() const noexcept
+    {
+        return oversampler != nullptr ? juce::roundToInt (oversampler->getLatencyInSamples()) : 0;
+    }
+
+    /** The latency setOversampling (order, filter) would give. The oversamplers
+        only change in prepare() and release(), so this needn't be asked on the
+        audio thread.
+    */
+    int getLatencyInSamples (int order, int filter) const noexcept
+    {
+        if (order <= 0 || order > maxOversamplingOrder || ! juce::isPositiveAndBelow (filter, (int) oversamplers.size()))
+            return 0;
+
+        auto& os = oversamplers[(size_t) filter][(size_t) order - 1];
+        return os != nullptr ? juce::roundToInt (os->getLatencyInSamples()) : 0;
+    }
+
+    /** How long the output keeps ringing after the input stops, from the poles of
+        every active section plus the oversampling latency. Safe to call from any
+        thread.
+    */
+    double getTailLengthSeconds() const noexcept
+    {
+        return tailLengthSeconds.load();
+    }
+
+    double getProcessingSampleRate() const noexcept
+    {
+        return sampleRate * (double) (1 << oversamplingOrder);
+    }
+
+    /** Sets the settings one parameter set's bands should move to. They are picked
+        up at the next grid point, and nothing is designed here. The dynamics
+        always come from the first set.
+    */
+    void setTargetBands (const ChainSettings& newTargets, size_t set = 0) noexcept
+    {
+        jassert (set < maxParameterSets);
+        targets[set] = newTargets;
+
+        // Only an SVF can follow the gain changes smoothly.
+        if (targets[0].dynamics.mode != DynamicsMode::Off)
+            targets[set].bands[ChainSettings::Peak].engine = BandEngine::SVF;
+
+        hasNewTargets = true;
+    }
+
+    //==============================================================================
+    /** Filters block in place. sidechain, which may have no channels, is only
+        listened to by a dynamic band in sidechain mode and must be at least as
+        long as block.
+    */
+    void process (juce::dsp::AudioBlock<SampleType>& block,
+                  const juce::dsp::AudioBlock<const SampleType>& sidechain = {}) noexcept
+    {
+        // Sub-blocks end at every grid point, and at maxBlockSize in case the host
+        // sends more samples than it promised in prepareToPlay.
+        for (size_t start = 0; start < block.getNumSamples();)
+        {
+            if (samplesUntilNextControlPoint == 0)
+            {
+                updateControl();
+                samplesUntilNextControlPoint = controlInterval;
+            }
+
+            auto numSamples = juce::jmin (block.getNumSamples() - start, samplesUntilNextControlPoint, maxBlockSize);
+            auto subBlock = block.getSubBlock (start, numSamples);
+
+            if (dynamicsMode == DynamicsMode::Sidechain)
+                dynamics.process (sidechain.getNumChannels() > 0 ? sidechain.getSubBlock (start, numSamples)
+                                                                 : juce::dsp::AudioBlock<const SampleType>());
+            else if (dynamicsMode == DynamicsMode::Band)
+                dynamics.process (subBlock);
+
+            start += numSamples;
+            samplesUntilNextControlPoint -= numSamples;
+
+            if (updateSilence (subBlock))
+                continue;
+
+            if (oversampler != nullptr)
+            {
+                auto oversampledBlock = oversampler->processSamplesUp (subBlock);
+                processChains (oversampledBlock);
+                oversampler->processSamplesDown (subBlock);
+            }
+            else
+            {
+                processChains (subBlock);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    /** Runs once per grid point: latches new targets, steps the smoothers and
+        redesigns whichever bands changed.
+    */
+    void updateControl() noexcept
+    {
+        std::array<std::array<bool, BandDesign::maxBands>, maxParameterSets> bandChanged {};
+        auto anyReshaped = false, anySVFChanged = false;
+
+        if (hasNewTargets)
+        {
+            dynamicsMode = targets[0].dynamics.mode;
+            dynamics.setSettings (targets[0].dynamics);
+        }
+
+        // The dynamic gain moves the Peak band like any other glide, as long as it
+        // has moved far enough to be worth a redesign.
+        auto gainOffset = dynamics.getGainOffsetInDecibels();
+
+        if (std::abs (gainOffset - peakGainOffset) > 0.01f || (gainOffset == 0.f && peakGainOffset != 0.f))
+        {
+            peakGainOffset = gainOffset;
+
+            for (auto& set : bandChanged)
+                set[ChainSettings::Peak] = true;
+        }
+
+        for (size_t set = 0; set < numSets; ++set)
+        {
+            for (size_t band = 0; band < BandDesign::maxBands; ++band)
+            {
+                auto change = updateBand (set, band, bandChanged[set][band]);
+
+                if (change != BandChange::none)
+                {
+                    anyReshaped = anyReshaped || change == BandChange::shape;
+                    anySVFChanged = anySVFChanged || currentBands[set].bands[band].engine == BandEngine::SVF;
+                }
+            }
+        }
+
+        hasNewTargets = false;
+        snapToTargets = false;
+
+        // A gain-only step keeps every band's sections and decay estimate, so
+        // the slot lists and the tail stay as they are.
+        if (anyReshaped)
+            updateActiveSlots();
+
+        // The ramp runs over the processed samples, so it spans one grid step at
+        // the oversampled rate.
+        if (anySVFChanged)
+            for (auto& chain : chains)
+                chain.svfs.startRamp (controlInterval << oversamplingOrder);
+    }
+
+    /** What a grid step did to a band: nothing, only its gain, or anything else. */
+    enum class BandChange
+    {
+        none,
+        gain,
+        shape
+    };
+
+    /** Latches a band's new target if there is one, steps its smoothers and
+        redesigns it if anything moved.
+    */
+    BandChange updateBand (size_t set, size_t band, bool changed) noexcept
+    {
+        auto& smoothed = smoothedBands[set][band];
+        auto& current = currentBands[set].bands[band];
+        auto jump = false;
+
+        if (hasNewTargets)
+        {
+            auto& target = targets[set].bands[band];
+
+            // Type, slope and engine can't glide, and neither can a band that was off.
+            if (snapToTargets || target.type != current.type || target.slope != current.slope
+                 || target.engine != current.engine)
+            {
+                current.type = target.type;
+                current.slope = target.slope;
+                current.engine = target.engine;
+                smoothed.frequency.setCurrentAndTargetValue (target.frequency);
+                smoothed.gain.setCurrentAndTargetValue (target.gainInDecibels);
+                smoothed.quality.setCurrentAndTargetValue (target.quality);
+                changed = jump = true;
+            }
+            else
+            {
+                smoothed.frequency.setTargetValue (target.frequency);
+                smoothed.gain.setTargetValue (target.gainInDecibels);
+                smoothed.quality.setTargetValue (target.quality);
+            }
+        }
+
+        // Whether the step only moves the gain, from its own glide or the dynamics.
+        auto gainOnly = ! jump && ! smoothed.frequency.isSmoothing() && ! smoothed.quality.isSmoothing();
+
+        if (smoothed.isSmoothing())
+        {
+            smoothed.frequency.getNextValue();
+            smoothed.gain.getNextValue();
+            smoothed.quality.getNextValue();
+            changed = true;
+        }
+
+        if (! changed)
+            return BandChange::none;
+
+        current.frequency = smoothed.frequency.getCurrentValue();
+        current.gainInDecibels = smoothed.gain.getCurrentValue();
+        current.quality = smoothed.quality.getCurrentValue();
+
+        return designBand (set, band, jump, gainOnly);
+    }
+
+    /** Designs one band of a parameter set at the processing rate and hands the
+        coefficients to each chain. ArrayCoefficients returns by value, so nothing
+        is allocated here. SVF bands ramp to their new coefficients unless jump
+        is set.
+
+        When only the gain has moved, as it does at every grid point while the
+        dynamics work, the detector keeps its tuning and the band keeps its decay
+        estimate, and an SVF bell just has its gain terms recomputed.
+    */
+    BandChange designBand (size_t set, size_t band, bool jump, bool gainOnly) noexcept
+    {
+        auto settings = currentBands[set].bands[band];
+        auto& numSections = numBandSections[set][band];
+        auto& decaySamples = bandDecaySamples[set][band];
+        auto previousNumSections = numSections;
+
+        if (band == ChainSettings::Peak)
+        {
+            settings.gainInDecibels += peakGainOffset;
+
+            if (set == 0 && ! gainOnly)
+                dynamics.setDetectorBand (settings.frequency, settings.quality);
+        }
+
+        // A band coming back from bypass has nothing sensible to ramp from, and
+        // one going into it loses its sections.
+        jump = jump || numSections == 0;
+        gainOnly = gainOnly && ! jump && ! BandDesign::isBypassed (settings);
+
+        auto isSVF = settings.engine == BandEngine::SVF;
+        auto& bellStage = bellStages[set][band];
+
+        if (gainOnly && isSVF && settings.type == BandType::Bell)
+        {
+            BandDesign::setSVFBellGain (bellStage, settings.quality, settings.gainInDecibels);
+            setSVFCoefficients (set, getSlot (band, 0), bellStage, false);
+            return BandChange::gain;
+        }
+
+        if (! gainOnly)
+            decaySamples = 0.0;
+
+        if (isSVF)
+        {
+            BandDesign::SVFStageCoefficients<SampleType> stages;
+            numSections = BandDesign::makeSVFStages (settings, getProcessingSampleRate(), stages);
+
+            if (numSections > 0)
+                bellStage = stages[0];
+
+            for (int i = 0; i < numSections; ++i)
+            {
+                setSVFCoefficients (set, getSlot (band, i), stages[(size_t) i], jump);
+
+                if (! gainOnly)
+                    decaySamples += BandDesign::getDecayTimeInSamples (BandDesign::toArrayCoefficients (stages[(size_t) i]),
+                                                                       silenceThresholdDecibels);
+            }
+        }
+        else
+        {
+            BandDesign::SectionCoefficients<SampleType> sections;
+            numSections = BandDesign::makeSections (settings, getProcessingSampleRate(), sections);
+
+            for (int i = 0; i < numSections; ++i)
+            {
+                setBiquadCoefficients (set, getSlot (band, i), sections[(size_t) i]);
+
+                if (! gainOnly)
+                    decaySamples += BandDesign::getDecayTimeInSamples (sections[(size_t) i], silenceThresholdDecibels);
+            }
+        }
+
+        auto change = gainOnly ? BandChange::gain : BandChange::shape;
+
+        if (numSets == 1)
+            return change;
+
+        // The other set may keep this band's slots running, so every slot this set
+        // doesn't use has to pass its lane straight through. Only a jump can move
+        // the band to the other bank or change its number of sections, bar
+        // gliding into bypass.
+        auto lastUnused = jump ? BandDesign::maxSectionsPerBand : previousNumSections;
+
+        for (int i = numSections; i < lastUnused; ++i)
+        {
+            if (isSVF)
+                setSVFCoefficients (set, getSlot (band, i), svfPassThrough, jump);
+            else
+                setBiquadCoefficients (set, getSlot (band, i), biquadPassThrough);
+        }
+
+        if (jump)
+        {
+            for (int i = 0; i < BandDesign::maxSectionsPerBand; ++i)
+            {
+                if (isSVF)
+                    setBiquadCoefficients (set, getSlot (band, i), biquadPassThrough);
+                else
+                    setSVFCoefficients (set, getSlot (band, i), svfPassThrough, true);
+            }
+        }
+
+        return change;
+    }
+
+    /** Sets a slot on every lane when all channels share the first parameter set,
+        and otherwise only on the lane of the given set.
+    */
+    void setBiquadCoefficients (size_t set, juce::uint16 slot, const std::array<SampleType, 6>& c) noexcept
+    {
+        for (auto& chain : chains)
+        {
+            if (numSets == 1)
+                chain.biquads.setCoefficients (slot, c);
+            else
+                chain.biquads.setLaneCoefficients (slot, set, c);
+        }
+    }
+
+    void setSVFCoefficients (size_t set, juce::uint16 slot, const BandDesign::SVFCoefficients<SampleType>& c, bool jump) noexcept
+    {
+        for (auto& chain : chains)
+        {
+            if (numSets == 1)
+                chain.svfs.setCoefficients (slot, { c.g, c.k, c.m0, c.m1, c.m2 }, jump);
+            else
+                chain.svfs.setLaneCoefficients (slot, set, { c.g, c.k, c.m0, c.m1, c.m2 }, jump);
+        }
+    }
+
+    /** Bypassed bands design no sections, so they never make it into the active
+        list. A slot runs if any parameter set uses it.
+    */
+    void updateActiveSlots() noexcept
+    {
+        std::array<juce::uint16, BandDesign::maxSections> biquadSlots, svfSlots;
+        size_t numBiquadSlots = 0, numSVFSlots = 0;
+
+        // The sets run side by side in their own lanes, so their sections only
+        // add up within a set.
+        std::array<double, maxParameterSets> setDecaySamples {};
+
+        for (size_t band = 0; band < BandDesign::maxBands; ++band)
+        {
+            int numBiquadSections = 0, numSVFSections = 0;
+
+            for (size_t set = 0; set < numSets; ++set)
+            {
+                auto& numSections = currentBands[set].bands[band].engine == BandEngine::SVF ? numSVFSections : numBiquadSections;
+                numSections = juce::jmax (numSections, numBandSections[set][band]);
+                setDecaySamples[set] += bandDecaySamples[set][band];
+            }
+
+            for (int i = 0; i < numBiquadSections; ++i)
+                biquadSlots[numBiquadSlots++] = getSlot (band, i);
+
+            for (int i = 0; i < numSVFSections; ++i)
+                svfSlots[numSVFSlots++] = getSlot (band, i);
+        }
+
+        for (auto& chain : chains)
+        {
+            chain.biquads.setActiveSlots (biquadSlots.data(), numBiquadSlots);
+            chain.svfs.setActiveSlots (svfSlots.data(), numSVFSlots);
+        }
+
+        // Summing the sections' decay times errs on the long side, which is what a
+        // host wants from a tail length.
+        auto decaySamples = *std::max_element (setDecaySamples.begin(), setDecaySamples.begin() + (std::ptrdiff_t) numSets);
+        tailLengthSeconds = decaySamples / getProcessingSampleRate() + getLatencyInSamples() / sampleRate;
+    }
+
+    /** Tracks how long each group's input has been silent, waking any group whose
+        input isn't. Returns true if every group is asleep, so the whole sub-block
+        can be skipped.
+    */
+    bool updateSilence (const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        constexpr auto lanes = ChannelLanes::numLanes<SIMDType>;
+        auto threshold = juce::Decibels::decibelsToGain ((SampleType) silenceThresholdDecibels, (SampleType) -200);
+        auto allAsleep = true;
+
+        for (size_t group = 0; group < groups.size(); ++group)
+        {
+            auto& state = groups[group];
+            auto isSilent = true;
+
+            for (size_t ch = group * lanes; ch < juce::jmin ((group + 1) * lanes, block.getNumChannels()) && isSilent; ++ch)
+            {
+                auto range = juce::FloatVectorOperations::findMinAndMax (block.getChannelPointer (ch), (int) block.getNumSamples());
+                isSilent = juce::jmax (-range.getStart(), range.getEnd()) <= threshold;
+            }
+
+            if (isSilent)
+            {
+                state.silentSamples += block.getNumSamples();
+            }
+            else
+            {
+                state.silentSamples = 0;
+                state.asleep = false;
+            }
+
+            allAsleep = allAsleep && state.asleep;
+        }
+
+        return allAsleep;
+    }
+
+    /** Puts a group to sleep if it has heard nothing for longer than the
+        oversampler holds on to and its filters have stopped ringing.
+    */
+    void updateSleep (size_t group) noexcept
+    {
+        auto& state = groups[group];
+        auto threshold = juce::Decibels::decibelsToGain ((SampleType) silenceThresholdDecibels, (SampleType) -200);
+
+        if (state.silentSamples > (size_t) getLatencyInSamples() && chains[group].isStateBelow (threshold))
+        {
+            chains[group].reset();
+            state.asleep = true;
+        }
+    }
+
+    static juce::uint16 getSlot (size_t band, int section) noexcept
+    {
+        return (juce::uint16) (band * (size_t) BandDesign::maxSectionsPerBand + (size_t) section);
+    }
+
+    void processChains (juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        auto laneBlock = interleaved.getSubBlock (0, block.getNumSamples());
+
+        for (size_t group = 0; group < chains.size(); ++group)
+        {
+            auto firstChannel = group * ChannelLanes::numLanes<SIMDType>;
+
+            if (firstChannel >= block.getNumChannels())
+                break;
+
+            if (groups[group].asleep)
+                continue;
+
+            // Mid/side is encoded and decoded in the same pass that moves the
+            // channels in and out of the lanes.
+            auto midSide = channelMode == ChannelMode::MidSide && group == 0;
+
+            if (midSide)
+                ChannelLanes::interleaveMidSide (block, laneBlock);
+            else
+                ChannelLanes::interleave (block, firstChannel, laneBlock);
+
+            juce::dsp::ProcessContextReplacing<SIMDType> context (laneBlock);
+            chains[group].process (context);
+
+            if (midSide)
+                ChannelLanes::deinterleaveMidSide (laneBlock, block);
+            else
+                ChannelLanes::deinterleave (laneBlock, block, firstChannel);
+
+            if (groups[group].silentSamples > 0)
+                updateSleep (group);
+        }
+    }
+
+    //==============================================================================
+    using Oversampling = juce::dsp::Oversampling<SampleType>;
+
+    // Each SIMD lane carries one channel, so a single chain filters
+    // SIMDType::size() channels of the bus in one pass. Band n owns slots
+    // [n * maxSectionsPerBand, (n + 1) * maxSectionsPerBand) of whichever bank
+    // its engine picks, and the same slots of the other bank stay inactive.
+    struct MonoChain
+    {
+        void prepare (const juce::dsp::ProcessSpec& spec)
+        {
+            biquads.prepare (spec);
+            svfs.prepare (spec);
+        }
+
+        void reset() noexcept
+        {
+            biquads.reset();
+            svfs.reset();
+        }
+
+        bool isStateBelow (SampleType threshold) const noexcept
+        {
+            return biquads.isStateBelow (threshold) && svfs.isStateBelow (threshold);
+        }
+
+        void process (const juce::dsp::ProcessContextReplacing<SIMDType>& context) noexcept
+        {
+            biquads.process (context);
+            svfs.process (context);
+        }
+
+        BiquadBank<SIMDType, (size_t) BandDesign::maxSections> biquads;
+        SVFBank<SIMDType, (size_t) BandDesign::maxSections> svfs;
+    };
+
+    // One chain per group of SIMDType::size() channels. Filter state is stored
+    // inline, so the whole bus lives in this one contiguous allocation.
+    std::vector<MonoChain> chains;
+
+    // Every factor of both filter types is built in prepare(), so switching mode
+    // on the audio thread only swaps a pointer. Indexed by [filter][order - 1].
+    std::array<std::array<std::unique_ptr<Oversampling>, maxOversamplingOrder>, 2> oversamplers;
+    Oversampling* oversampler = nullptr; // null when running at 1x
+    int oversamplingOrder = 0;
+
+    double sampleRate = 0.0;
+    size_t maxBlockSize = 0, numChannelsPrepared = 0;
+
+    ChannelMode requestedChannelMode = ChannelMode::Stereo, channelMode = ChannelMode::Stereo;
+    size_t numSets = 1;
+
+    struct SmoothedBand
+    {
+        bool isSmoothing() const noexcept    { return frequency.isSmoothing() || gain.isSmoothing() || quality.isSmoothing(); }
+
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> frequency { 1000.f }, quality { 1.f };
+        juce::SmoothedValue<float> gain;
+    };
+
+    // Targets arrive once per host block; currentBands is what the filters are
+    // designed from, and only ever changes on the control grid. Everything here
+    // is kept per parameter set, of which only the first numSets are used.
+    template <typename Type>
+    using PerSet = std::array<Type, maxParameterSets>;
+
+    PerSet<ChainSettings> targets, currentBands;
+    PerSet<std::array<SmoothedBand, BandDesign::maxBands>> smoothedBands;
+    PerSet<std::array<int, BandDesign::maxBands>> numBandSections {};
+
+    // Each SVF band's first stage as last designed, kept so that a bell's gain
+    // can move without redesigning it.
+    PerSet<std::array<BandDesign::SVFCoefficients<SampleType>, BandDesign::maxBands>> bellStages {};
+
+    // What a slot holds on a lane whose set doesn't use it. The SVF is damped so
+    // that any leftover state still dies away.
+    static constexpr std::array<SampleType, 6> biquadPassThrough { 1, 0, 0, 1, 0, 0 };
+    static constexpr BandDesign::SVFCoefficients<SampleType> svfPassThrough { 1, 2, 1, 0, 0 };
+
+    DynamicGain<SampleType> dynamics;
+    DynamicsMode dynamicsMode = DynamicsMode::Off;
+    float peakGainOffset = 0.f;
+    bool hasNewTargets = false, snapToTargets = true;
+    size_t samplesUntilNextControlPoint = 0;
+
+    struct GroupState
+    {
+        size_t silentSamples = 0;
+        bool asleep = false;
+    };
+
+    std::vector<GroupState> groups;
+    PerSet<std::array<double, BandDesign::maxBands>> bandDecaySamples {};
+    std::atomic<double> tailLengthSeconds { 0.0 };
+
+    juce::HeapBlock<char> interleavedBlockData;
+    juce::dsp::AudioBlock<SIMDType> interleaved;
+};
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    FilterResponse.cpp
+    Created: 17 Oct 2026 1:41:09pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "FilterResponse.h"
+#include "PluginProcessor.h"
+
+namespace FilterResponse
+{
+    void applyChainMagnitudes (const ChainSettings& chainSettings, double designSampleRate,
+                               const double* frequencies, double* magnitudes, size_t numFrequencies)
+    {
+        // Designed in double precision: low cut-offs at high design rates put the poles
+        // close enough to the unit circle for float coefficients to go wrong here.
+        std::vector<std::array<double, 6>> sections;
+        BandDesign::SectionCoefficients<double> bandSections;
+        BandDesign::SVFStageCoefficients<double> svfStages;
+
+        for (auto& band : chainSettings.bands)
+        {
+            if (band.engine == BandEngine::SVF)
+            {
+                auto numStages = BandDesign::makeSVFStages (band, designSampleRate, svfStages);
+
+                for (int i = 0; i < numStages; ++i)
+                    sections.push_back (BandDesign::toArrayCoefficients (svfStages[(size_t) i]));
+            }
+            else
+            {
+                auto numSections = BandDesign::makeSections (band, designSampleRate, bandSections);
+                sections.insert (sections.end(), bandSections.begin(), bandSections.begin() + numSections);
+            }
+        }
+
+        // Each section's squared magnitude is (B0 + B1 cos w + B2 cos 2w) / (A0 + A1 cos w + A2 cos 2w).
+        // The numerators and denominators are multiplied up separately, which leaves
+        // branch-free multiply-adds over contiguous arrays for the compiler to
+        // vectorise, and a single divide per frequency at the end.
+        std::vector<double> cosW (numFrequencies), cos2W (numFrequencies);
+        std::vector<double> numerator (numFrequencies, 1.0), denominator (numFrequencies, 1.0);
+
+        for (size_t i = 0; i < numFrequencies; ++i)
+        {
+            auto w = juce::MathConstants<double>::twoPi * frequencies[i] / designSampleRate;
+            cosW[i] = std::cos (w);
+            cos2W[i] = std::cos (2.0 * w);
+        }
+
+        for (auto& c : sections)
+        {
+            auto num0 = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+            auto num1 = 2.0 * (c[0] * c[1] + c[1] * c[2]);
+            auto num2 = 2.0 * c[0] * c[2];
+            auto den0 = c[3] * c[3] + c[4] * c[4] + c[5] * c[5];
+            auto den1 = 2.0 * (c[3] * c[4] + c[4] * c[5]);
+            auto den2 = 2.0 * c[3] * c[5];
+
+            auto* num = numerator.data();
+            auto* den = denominator.data();
+            auto* c1 = cosW.data();
+            auto* c2 = cos2W.data();
+
+            for (size_t i = 0; i < numFrequencies; ++i)
+            {
+                num[i] *= num0 + num1 * c1[i] + num2 * c2[i];
+                den[i] *= den0 + den1 * c1[i] + den2 * c2[i];
+            }
+        }
+
+        for (size_t i = 0; i < numFrequencies; ++i)
+            magnitudes[i] *= std::sqrt (juce::jmax (0.0, numerator[i] / denominator[i]));
+    }
+}
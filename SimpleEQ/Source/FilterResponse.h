@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    FilterResponse.h
+    Created: 17 Oct 2026 1:41:09pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+struct ChainSettings;
+
+namespace FilterResponse
+{
+    /** Squared magnitude of a biquad given as { b0, b1, b2, a0, a1, a2 }, at the
+        normalised angular frequency w, where cosW = cos (w) and cos2W = cos (2w).
+    */
+    template <typename NumericType>
+    inline double getMagnitudeSquared (const std::array<NumericType, 6>& c, double cosW, double cos2W) noexcept
+    {
+        auto b0 = (double) c[0], b1 = (double) c[1], b2 = (double) c[2];
+        auto a0 = (double) c[3], a1 = (double) c[4], a2 = (double) c[5];
+
+        auto num = b0 * b0 + b1 * b1 + b2 * b2 + 2.0 * (b0 * b1 + b1 * b2) * cosW + 2.0 * b0 * b2 * cos2W;
+        auto den = a0 * a0 + a1 * a1 + a2 * a2 + 2.0 * (a0 * a1 + a1 * a2) * cosW + 2.0 * a0 * a2 * cos2W;
+
+        return num / den;
+    }
+
+    /** Multiplies every entry of magnitudes by the linear magnitude response of the
+        chain described by chainSettings, designed for designSampleRate, at the
+        matching entry of frequencies (in Hz).
+
+        This allocates scratch space, so don't call it on the audio thread.
+    */
+    void applyChainMagnitudes (const ChainSettings& chainSettings, double designSampleRate,
+                               const double* frequencies, double* magnitudes, size_t numFrequencies);
+}
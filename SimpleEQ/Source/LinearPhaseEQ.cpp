@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+
+    LinearPhaseEQ.cpp
+    Created: 17 Oct 2026 1:58:33pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseEQ.h"
+#include "FilterResponse.h"
+#include "PluginProcessor.h"
+
+LinearPhaseEQ::LinearPhaseEQ (juce::AudioProcessorValueTreeState& apvtsToUse)
+    : juce::Thread ("Linear phase kernel designer"), apvts (apvtsToUse)
+{
+}
+
+LinearPhaseEQ::~LinearPhaseEQ()
+{
+    cancelPendingUpdate();
+    stopThread (2000);
+}
+
+//==============================================================================
+void LinearPhaseEQ::prepare (double newSampleRate, int newNumChannels)
+{
+    stopThread (2000);
+
+    sampleRate = newSampleRate;
+    numChannels = (size_t) juce::jmax (1, newNumChannels);
+
+    // Roughly 170 ms of design resolution, whatever the sample rate.
+    designSize = (size_t) juce::nextPowerOfTwo (juce::roundToInt (sampleRate * 0.17));
+    designFFT = std::make_unique<juce::dsp::FFT> (juce::roundToInt (std::log2 ((double) designSize)));
+
+    // An odd length keeps the group delay a whole number of samples.
+    kernelLength = designSize / 2 - 1;
+    numPartitions = (kernelLength + partitionSize - 1) / partitionSize;
+
+    for (auto& kernel : kernels)
+        kernel.assign (numPartitions * numBins, {});
+
+    inputSpectra.assign (numChannels * numPartitions * numBins, {});
+    accumulator.assign (numBins, {});
+    inputHistory.assign (numChannels * fftSize, 0.0f);
+    outputFifo.assign (numChannels * partitionSize, 0.0f);
+    fftBuffer.assign (fftSize * 2, 0.0f);
+    fadeBuffer.assign (partitionSize, 0.0f);
+
+    designFrequencies.resize (designSize / 2 + 1);
+    designMagnitudes.resize (designSize / 2 + 1);
+    designBuffer.assign (designSize * 2, 0.0f);
+    kernelBuffer.assign (fftSize * 2, 0.0f);
+    window.resize (kernelLength);
+
+    for (size_t i = 0; i < designFrequencies.size(); ++i)
+        designFrequencies[i] = (double) i * sampleRate / (double) designSize;
+
+    juce::dsp::WindowingFunction<float>::fillWindowingTables (window.data(), kernelLength,
+                                                              juce::dsp::WindowingFunction<float>::blackmanHarris, false);
+
+    activeKernel = 0;
+    designKernel (activeKernel);
+
+    kernelState = idle;
+    kernelRequested = false;
+    reset();
+
+    if (isActive)
+        startThread();
+}
+
+void LinearPhaseEQ::reset() noexcept
+{
+    std::fill (inputSpectra.begin(), inputSpectra.end(), Complex());
+    std::fill (inputHistory.begin(), inputHistory.end(), 0.0f);
+    std::fill (outputFifo.begin(), outputFifo.end(), 0.0f);
+
+    fifoPosition = 0;
+    spectrumPosition = 0;
+}
+
+void LinearPhaseEQ::setActive (bool shouldBeActive)
+{
+    isActive = shouldBeActive;
+
+    if (! isActive)
+    {
+        stopThread (2000);
+        return;
+    }
+
+    // Nothing to design with until prepare(), which starts the thread itself.
+    if (designFFT == nullptr || isThreadRunning())
+        return;
+
+    // The parameters may have moved while the thread was stopped.
+    kernelRequested = true;
+    startThread();
+}
+
+void LinearPhaseEQ::requestKernelUpdate() noexcept
+{
+    // notify() takes the WaitableEvent's lock, which the audio thread mustn't.
+    kernelRequested = true;
+    triggerAsyncUpdate();
+}
+
+void LinearPhaseEQ::handleAsyncUpdate()
+{
+    notify();
+}
+
+int LinearPhaseEQ::getLatencyInSamples() const noexcept
+{
+    return (int) (partitionSize + (kernelLength - 1) / 2);
+}
+
+int LinearPhaseEQ::getTailLengthInSamples() const noexcept
+{
+    return (int) (partitionSize + kernelLength - 1);
+}
+
+//==============================================================================
+template <typename SampleType>
+void LinearPhaseEQ::process (juce::dsp::AudioBlock<SampleType>& block) noexcept
+{
+    auto channelsToProcess = juce::jmin (numChannels, block.getNumChannels());
+    auto numSamples = block.getNumSamples();
+
+    for (size_t done = 0; done < numSamples;)
+    {
+        auto todo = juce::jmin (numSamples - done, partitionSize - fifoPosition);
+
+        for (size_t ch = 0; ch < channelsToProcess; ++ch)
+        {
+            auto* io = block.getChannelPointer (ch) + done;
+            auto* input = inputHistory.data() + ch * fftSize + partitionSize + fifoPosition;
+            auto* output = outputFifo.data() + ch * partitionSize + fifoPosition;
+
+            std::transform (io, io + todo, input, [] (SampleType x) { return static_cast<float> (x); });
+            std::transform (output, output + todo, io, [] (float x) { return static_cast<SampleType> (x); });
+        }
+
+        done += todo;
+        fifoPosition += todo;
+
+        if (fifoPosition == partitionSize)
+        {
+            processPartition();
+            fifoPosition = 0;
+        }
+    }
+}
+
+template void LinearPhaseEQ::process (juce::dsp::AudioBlock<float>&) noexcept;
+template void LinearPhaseEQ::process (juce::dsp::AudioBlock<double>&) noexcept;
+
+void LinearPhaseEQ::processPartition() noexcept
+{
+    if (kernelState.load() == ready)
+    {
+        activeKernel = 1 - activeKernel;
+        isFading = true;
+        kernelState = fading;
+    }
+
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto* history = inputHistory.data() + ch * fftSize;
+        auto* spectra = inputSpectra.data() + ch * numPartitions * numBins;
+        auto* output = outputFifo.data() + ch * partitionSize;
+
+        // Overlap-save: transform the previous and current partitions together
+        // and keep only the second half of the circular result.
+        std::copy (history, history + fftSize, fftBuffer.begin());
+        std::fill (fftBuffer.begin() + (long) fftSize, fftBuffer.end(), 0.0f);
+        convolutionFFT.performRealOnlyForwardTransform (fftBuffer.data(), true);
+
+        auto* newest = reinterpret_cast<const Complex*> (fftBuffer.data());
+        std::copy (newest, newest + numBins, spectra + spectrumPosition * numBins);
+
+        convolve (spectra, kernels[activeKernel].data(), accumulator.data());
+        inverseTransform (accumulator.data());
+        std::copy (fftBuffer.begin() + (long) partitionSize, fftBuffer.begin() + (long) fftSize, output);
+
+        if (isFading)
+        {
+            convolve (spectra, kernels[1 - activeKernel].data(), accumulator.data());
+            inverseTransform (accumulator.data());
+
+            for (size_t i = 0; i < partitionSize; ++i)
+            {
+                auto fadeIn = (float) (i + 1) / (float) partitionSize;
+                output[i] = output[i] * fadeIn + fftBuffer[partitionSize + i] * (1.0f - fadeIn);
+            }
+        }
+
+        std::copy (history + partitionSize, history + fftSize, history);
+    }
+
+    spectrumPosition = (spectrumPosition + 1) % numPartitions;
+
+    if (isFading)
+    {
+        isFading = false;
+        kernelState = idle;
+    }
+}
+
+void LinearPhaseEQ::convolve (const Complex* spectra, const Complex* kernel, Complex* output) const noexcept
+{
+    std::fill (output, output + numBins, Complex());
+
+    for (size_t p = 0; p < numPartitions; ++p)
+    {
+        // Partition p of the kernel meets the input from p partitions ago.
+        auto* input = spectra + ((spectrumPosition + numPartitions - p) % numPartitions) * numBins;
+        auto* kernelPartition = kernel + p * numBins;
+
+        for (size_t bin = 0; bin < numBins; ++bin)
+            output[bin] += input[bin] * kernelPartition[bin];
+    }
+}
+
+void LinearPhaseEQ::inverseTransform (const Complex* spectrum) noexcept
+{
+    std::copy (spectrum, spectrum + numBins, reinterpret_cast<Complex*> (fftBuffer.data()));
+    convolutionFFT.performRealOnlyInverseTransform (fftBuffer.data());
+}
+
+//==============================================================================
+void LinearPhaseEQ::run()
+{
+    while (! threadShouldExit())
+    {
+        if (kernelRequested.load() && kernelState.load() == idle)
+        {
+            kernelRequested = false;
+            designKernel (1 - activeKernel);
+            kernelState = ready;
+        }
+        else if (kernelRequested.load())
+        {
+            // The audio thread still owns the spare slot, which it gives back
+            // within a partition or two.
+            wait (pollIntervalMs);
+        }
+        else
+        {
+            wait (-1);
+        }
+    }
+}
+
+void LinearPhaseEQ::designKernel (size_t kernelIndex)
+{
+    auto chainSettings = getChainSettings (apvts);
+
+    std::fill (designMagnitudes.begin(), designMagnitudes.end(), 1.0);
+    FilterResponse::applyChainMagnitudes (chainSettings, sampleRate * designOversampling,
+                                          designFrequencies.data(), designMagnitudes.data(), designMagnitudes.size());
+
+    // A real, zero-phase spectrum gives a real impulse response that is symmetric
+    // around sample 0 of the circular buffer.
+    std::fill (designBuffer.begin(), designBuffer.end(), 0.0f);
+
+    for (size_t bin = 0; bin < designMagnitudes.size(); ++bin)
+        designBuffer[bin * 2] = (float) designMagnitudes[bin];
+
+    designFFT->performRealOnlyInverseTransform (designBuffer.data());
+
+    auto& kernel = kernels[kernelIndex];
+    auto centre = (kernelLength - 1) / 2;
+
+    for (size_t p = 0; p < numPartitions; ++p)
+    {
+        std::fill (kernelBuffer.begin(), kernelBuffer.end(), 0.0f);
+
+        for (size_t i = 0; i < partitionSize; ++i)
+        {
+            auto n = p * partitionSize + i;
+
+            if (n >= kernelLength)
+                break;
+
+            kernelBuffer[i] = designBuffer[(n + designSize - centre) % designSize] * window[n];
+        }
+
+        kernelFFT.performRealOnlyForwardTransform (kernelBuffer.data(), true);
+
+        auto* spectrum = reinterpret_cast<const Complex*> (kernelBuffer.data());
+        std::copy (spectrum, spectrum + numBins, kernel.begin() + (long) (p * numBins));
+    }
+}
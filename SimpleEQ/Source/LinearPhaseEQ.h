@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    LinearPhaseEQ.h
+    Created: 17 Oct 2026 1:58:33pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Runs the EQ as a symmetric FIR through a uniformly partitioned overlap-save
+    convolution.
+
+    The kernel is designed from the magnitude response of the current
+    ChainSettings on a background thread, partitioned and transformed there, and
+    written into whichever of the two kernel slots the audio thread isn't using.
+    The audio thread picks it up at the next partition boundary and crossfades
+    from the old kernel over one partition, so it never runs the kernel design.
+    The thread only runs while the EQ is active, and sleeps until it is asked
+    for a kernel, so an instance in minimum phase mode costs nothing.
+
+    The frequency-domain delay line means each partition costs one forward FFT,
+    one complex multiply-accumulate per kernel partition and one inverse FFT per
+    channel, with all FFT plans built in prepare().
+*/
+class LinearPhaseEQ  : private juce::Thread,
+                       private juce::AsyncUpdater
+{
+public:
+    explicit LinearPhaseEQ (juce::AudioProcessorValueTreeState& apvts);
+    ~LinearPhaseEQ() override;
+
+    //==============================================================================
+    /** Allocates everything and designs the first kernel before returning. */
+    void prepare (double sampleRate, int numChannels);
+    void reset() noexcept;
+
+    /** Starts the background thread when the phase mode switches to linear, and
+        stops it when it switches back. Call from the message thread.
+    */
+    void setActive (bool shouldBeActive);
+
+    /** Asks the background thread to design a new kernel from the current parameter
+        values. Safe to call from the audio thread: it sets a flag and leaves
+        waking the thread, which takes a lock, to the message thread.
+    */
+    void requestKernelUpdate() noexcept;
+
+    /** The convolution itself always runs in single precision. Doubles are
+        converted on the way into and out of the partition buffers, which the
+        samples pass through anyway, so no extra copy is made.
+    */
+    template <typename SampleType>
+    void process (juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /** The partition buffering plus the group delay of the symmetric kernel. */
+    int getLatencyInSamples() const noexcept;
+
+    /** How long after the input stops the output keeps going: the partition
+        buffering plus the whole kernel.
+    */
+    int getTailLengthInSamples() const noexcept;
+
+    /** The magnitudes are sampled from the chain designed at this multiple of the
+        sample rate, which keeps the bilinear cramping out of the kernel.
+    */
+    static constexpr double designOversampling = 8.0;
+
+private:
+    //==============================================================================
+    void run() override;
+    void handleAsyncUpdate() override;
+    void designKernel (size_t kernelIndex);
+    void processPartition() noexcept;
+    void convolve (const std::complex<float>* spectra, const std::complex<float>* kernel, std::complex<float>* output) const noexcept;
+    void inverseTransform (const std::complex<float>* spectrum) noexcept;
+
+    //==============================================================================
+    using Complex = std::complex<float>;
+
+    static constexpr int partitionOrder = 9;
+    static constexpr int pollIntervalMs = 5;
+    static constexpr size_t partitionSize = (size_t) 1 << partitionOrder;
+    static constexpr size_t fftSize = partitionSize * 2;
+    static constexpr size_t numBins = fftSize / 2 + 1;
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    juce::dsp::FFT convolutionFFT { partitionOrder + 1 }, kernelFFT { partitionOrder + 1 };
+    std::unique_ptr<juce::dsp::FFT> designFFT;
+
+    double sampleRate = 44100.0;
+    size_t designSize = 0, kernelLength = 0, numPartitions = 0, numChannels = 0;
+
+    // Each kernel slot holds numPartitions spectra of numBins bins.
+    std::array<std::vector<Complex>, 2> kernels;
+    size_t activeKernel = 0;
+    bool isFading = false;
+
+    enum KernelState
+    {
+        idle,    // the background thread may write the inactive slot
+        ready,   // the inactive slot holds a new kernel waiting to be picked up
+        fading   // the audio thread is crossfading away from the inactive slot
+    };
+
+    std::atomic<int> kernelState { idle };
+    std::atomic<bool> kernelRequested { false };
+    std::atomic<bool> isActive { false };
+
+    // Audio thread state. Per-channel data is stored back to back.
+    std::vector<Complex> inputSpectra, accumulator;
+    std::vector<float> inputHistory, outputFifo, fftBuffer, fadeBuffer;
+    size_t fifoPosition = 0, spectrumPosition = 0;
+
+    // Only touched by whichever thread is designing a kernel.
+    std::vector<double> designFrequencies, designMagnitudes;
+    std::vector<float> designBuffer, kernelBuffer, window;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LinearPhaseEQ)
+};
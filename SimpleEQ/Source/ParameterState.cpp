@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    ParameterState.cpp
+    Created: 17 Oct 2026 6:20:05pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "ParameterState.h"
+
+ParameterState::ParameterState (juce::AudioProcessorValueTreeState& stateToUse)
+    : apvts (stateToUse)
+{
+    for (auto* param : apvts.processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (param))
+        {
+            sortedHashes.emplace_back (hashParameterID (ranged->paramID), parameters.size());
+            parameters.push_back (ranged);
+            hashes.push_back (sortedHashes.back().first);
+        }
+    }
+
+    std::sort (sortedHashes.begin(), sortedHashes.end());
+
+    // Two IDs sharing a hash would make one of them unrecallable.
+    jassert (std::adjacent_find (sortedHashes.begin(), sortedHashes.end(),
+                                 [] (auto& a, auto& b) { return a.first == b.first; }) == sortedHashes.end());
+}
+
+//==============================================================================
+void ParameterState::save (juce::MemoryBlock& destData) const
+{
+    destData.setSize (headerSize + parameters.size() * entrySize);
+    auto* dest = static_cast<char*> (destData.getData());
+
+    auto writeUint32 = [&dest] (juce::uint32 value)
+    {
+        value = juce::ByteOrder::swapIfBigEndian (value);
+        std::memcpy (dest, &value, sizeof (value));
+        dest += sizeof (value);
+    };
+
+    writeUint32 (magic);
+    writeUint32 ((juce::uint32) currentVersion);
+    writeUint32 ((juce::uint32) parameters.size());
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        auto value = parameters[i]->convertFrom0to1 (parameters[i]->getValue());
+        juce::uint32 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+
+        writeUint32 (hashes[i]);
+        writeUint32 (bits);
+    }
+}
+
+bool ParameterState::load (const void* data, size_t sizeInBytes)
+{
+    auto* source = static_cast<const char*> (data);
+
+    auto readUint32 = [] (const char* from)
+    {
+        juce::uint32 value;
+        std::memcpy (&value, from, sizeof (value));
+        return juce::ByteOrder::swapIfBigEndian (value);
+    };
+
+    if (sizeInBytes < headerSize || readUint32 (source) != magic)
+        return false;
+
+    auto version = (juce::uint16) (readUint32 (source + 4) & 0xffff);
+
+    if (version == 0 || version > currentVersion)
+        return false;
+
+    auto numEntries = (size_t) readUint32 (source + 8);
+
+    if (numEntries > (sizeInBytes - headerSize) / entrySize)
+        return false;
+
+    std::vector<bool> isLoaded (parameters.size(), false);
+
+    for (size_t entry = 0; entry < numEntries; ++entry)
+    {
+        auto* entryData = source + headerSize + entry * entrySize;
+        auto idHash = readUint32 (entryData);
+        auto bits = readUint32 (entryData + 4);
+
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+
+        if (entry < hashes.size() && hashes[entry] == idHash)
+        {
+            setParameter (entry, value);
+            isLoaded[entry] = true;
+            continue;
+        }
+
+        auto found = std::lower_bound (sortedHashes.begin(), sortedHashes.end(), std::make_pair (idHash, (size_t) 0));
+
+        if (found != sortedHashes.end() && found->first == idHash)
+        {
+            setParameter (found->second, value);
+            isLoaded[found->second] = true;
+        }
+    }
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+        if (! isLoaded[i])
+            setNormalisedParameter (i, parameters[i]->getDefaultValue());
+
+    return true;
+}
+
+//==============================================================================
+void ParameterState::setParameter (size_t index, float value)
+{
+    setNormalisedParameter (index, parameters[index]->convertTo0to1 (value));
+}
+
+void ParameterState::setNormalisedParameter (size_t index, float normalised)
+{
+    auto* param = parameters[index];
+
+    // Most of a session is usually at its defaults, so skip the notifications
+    // for anything that hasn't actually moved.
+    if (normalised != param->getValue())
+        param->setValueNotifyingHost (normalised);
+}
+
+juce::uint32 ParameterState::hashParameterID (const juce::String& paramID) noexcept
+{
+    // FNV-1a over the UTF-8 bytes, spelled out so the hashes never depend on the
+    // JUCE version a session was saved with.
+    juce::uint32 hash = 2166136261u;
+
+    for (auto* c = paramID.toRawUTF8(); *c != 0; ++c)
+    {
+        hash ^= (juce::uint8) *c;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
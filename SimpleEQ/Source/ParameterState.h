@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    ParameterState.h
+    Created: 17 Oct 2026 6:20:05pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Saves and restores every parameter of an AudioProcessorValueTreeState in a
+    small versioned binary format, without going through a ValueTree or XML.
+
+    The format is little-endian:
+
+        uint32  magic ("SQEB")
+        uint16  version
+        uint16  reserved
+        uint32  number of entries
+        entries of { uint32 hash of the parameter ID, float32 value }
+
+    Values are stored unnormalised, so they survive range changes. When the
+    entries come back in the order this build lays the parameters out in, each
+    one is matched positionally; anything else, such as a parameter added or
+    removed in another version, is looked up by hash and unknown IDs are skipped.
+    Parameters with no entry go back to their defaults, as they would with an
+    XML state. Data appended after the entries is ignored, so that can be added
+    without a new version; the version only changes when the header or entries
+    would mean something else, and versions this build doesn't know are
+    rejected.
+*/
+class ParameterState
+{
+public:
+    explicit ParameterState (juce::AudioProcessorValueTreeState&);
+
+    void save (juce::MemoryBlock& destData) const;
+
+    /** Returns false, leaving the parameters untouched, if data isn't in this
+        format or is from a version this build can't read, so the caller can
+        try the XML fallback.
+    */
+    bool load (const void* data, size_t sizeInBytes);
+
+    static constexpr juce::uint16 currentVersion = 1;
+
+private:
+    static juce::uint32 hashParameterID (const juce::String& paramID) noexcept;
+    void setParameter (size_t index, float value);
+    void setNormalisedParameter (size_t index, float normalised);
+
+    struct Entry
+    {
+        juce::uint32 idHash;
+        float value;
+    };
+
+    static constexpr juce::uint32 magic = 0x42455153; // "SQEB" read as little-endian
+    static constexpr size_t headerSize = 12;
+    static constexpr size_t entrySize = 8;
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    std::vector<juce::RangedAudioParameter*> parameters;
+    std::vector<juce::uint32> hashes;
+
+    // (hash, index into parameters), sorted by hash for the out-of-order case.
+    std::vector<std::pair<juce::uint32, size_t>> sortedHashes;
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterState)
+};
@@ -11,11 +11,13 @@
 
 //==============================================================================
 SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor (SimpleEQAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p), analyser (p), responseCurve (p), parameterEditor (p)
 {
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    addAndMakeVisible (analyser);
+    addAndMakeVisible (responseCurve);
+    addAndMakeVisible (parameterEditor);
+
+    setSize (600, 640);
 }
 
 SimpleEQAudioProcessorEditor::~SimpleEQAudioProcessorEditor()
@@ -28,13 +30,38 @@ void SimpleEQAudioProcessorEditor::paint (juce::Graphics& g)
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
 
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
+    auto area = getAnalysisArea();
+
+    g.setColour (juce::Colours::black);
+    g.fillRect (area);
+
+    // Decade and octave-ish frequency lines, plus a line every 12 dB.
+    g.setColour (juce::Colours::dimgrey.withAlpha (0.5f));
+
+    for (auto frequency : { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f })
+    {
+        auto x = area.getX() + juce::mapFromLog10 (frequency, SpectrumAnalyser::minFrequency, SpectrumAnalyser::maxFrequency) * area.getWidth();
+        g.drawVerticalLine (juce::roundToInt (x), (float) area.getY(), (float) area.getBottom());
+    }
+
+    for (auto decibels = SpectrumAnalyser::maxDecibels; decibels > SpectrumAnalyser::minDecibels; decibels -= 12.0f)
+    {
+        auto y = juce::jmap (decibels, SpectrumAnalyser::minDecibels, SpectrumAnalyser::maxDecibels, (float) area.getBottom(), (float) area.getY());
+        g.drawHorizontalLine (juce::roundToInt (y), (float) area.getX(), (float) area.getRight());
+    }
 }
 
 void SimpleEQAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    analyser.setBounds (getAnalysisArea());
+    responseCurve.setBounds (getAnalysisArea());
+
+    auto bounds = getLocalBounds();
+    bounds.removeFromTop (getAnalysisArea().getBottom());
+    parameterEditor.setBounds (bounds);
+}
+
+juce::Rectangle<int> SimpleEQAudioProcessorEditor::getAnalysisArea() const
+{
+    return getLocalBounds().removeFromTop (getHeight() / 3).reduced (8);
 }
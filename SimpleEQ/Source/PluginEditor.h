@@ -10,9 +10,13 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "SpectrumAnalyser.h"
+#include "ResponseCurve.h"
 
 //==============================================================================
 /**
+    The spectrum analyser and response curve across the top, with the generic
+    parameter controls underneath them.
 */
 class SimpleEQAudioProcessorEditor  : public juce::AudioProcessorEditor
 {
@@ -29,5 +33,11 @@ private:
     // access the processor object that created it.
     SimpleEQAudioProcessor& audioProcessor;
 
+    SpectrumAnalyser analyser;
+    ResponseCurve responseCurve;
+    juce::GenericAudioProcessorEditor parameterEditor;
+
+    juce::Rectangle<int> getAnalysisArea() const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
 };
@@ -9,6 +9,107 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    struct BandParameterIDs
+    {
+        juce::String type, freq, gain, quality, slope, engine;
+    };
+    
+    constexpr auto numParameterSets = EQChain<float>::maxParameterSets;
+    
+    /** IDs of one parameter set's band parameters. The first set has the original
+        IDs, "LowCut Freq", "Band4 Type" and so on, and the second, which drives
+        the side or right channel, has the same IDs with "Side " in front. The
+        fixed bands leave the IDs of settings they don't have empty. Built once,
+        the first time the parameter layout is created, so reading the bands on
+        the audio thread never builds a string.
+    */
+    const std::array<BandParameterIDs, BandDesign::maxBands>& getBandParameterIDs(size_t set)
+    {
+        static const auto ids = []
+        {
+            std::array<std::array<BandParameterIDs, BandDesign::maxBands>, numParameterSets> result;
+            
+            for (size_t set = 0; set < numParameterSets; ++set)
+            {
+                auto& setIDs = result[set];
+                juce::String setPrefix = set == 0 ? "" : "Side ";
+                
+                setIDs[ChainSettings::LowCut] = { {}, setPrefix + "LowCut Freq", {}, {}, setPrefix + "LowCut Slope", setPrefix + "LowCut Engine" };
+                setIDs[ChainSettings::Peak] = { {}, setPrefix + "Peak Freq", setPrefix + "Peak Gain", setPrefix + "Peak Quality", {}, setPrefix + "Peak Engine" };
+                setIDs[ChainSettings::HighCut] = { {}, setPrefix + "HighCut Freq", {}, {}, setPrefix + "HighCut Slope", setPrefix + "HighCut Engine" };
+                
+                for (int band = BandDesign::numFixedBands; band < BandDesign::maxBands; ++band)
+                {
+                    auto prefix = setPrefix + "Band" + juce::String(band + 1) + " ";
+                    setIDs[(size_t) band] = { prefix + "Type", prefix + "Freq", prefix + "Gain", prefix + "Quality", prefix + "Slope", prefix + "Engine" };
+                }
+            }
+            
+            return result;
+        }();
+        
+        return ids[set];
+    }
+    
+    /** Adds the band parameters of one set, in the order the first set has always had. */
+    void addBandParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, size_t set)
+    {
+        auto& ids = getBandParameterIDs(set);
+        juce::String namePrefix = set == 0 ? "" : "Side ";
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids[ChainSettings::LowCut].freq, namePrefix + "LowCut freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f), 20.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids[ChainSettings::HighCut].freq, namePrefix + "HighCut freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f), 20000.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids[ChainSettings::Peak].freq, namePrefix + "Peak freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f), 750.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids[ChainSettings::Peak].gain, namePrefix + "Peak Gain", juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(ids[ChainSettings::Peak].quality, namePrefix + "Peak Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.0f));
+        
+        juce::StringArray stringArray;
+        for(int i = 0; i < 4; i++){
+            juce::String str;
+            str << (12+i*12);
+            str << " db/Oct";
+            stringArray.add(str);
+        }
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(ids[ChainSettings::LowCut].slope, ids[ChainSettings::LowCut].slope, stringArray, 0));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>(ids[ChainSettings::HighCut].slope, ids[ChainSettings::HighCut].slope, stringArray, 0));
+        
+        // Biquads are the cheapest to run; SVFs can be swept at audio rate.
+        for (auto band : { ChainSettings::LowCut, ChainSettings::Peak, ChainSettings::HighCut })
+            layout.add(std::make_unique<juce::AudioParameterChoice>(ids[band].engine, ids[band].engine, BandDesign::getEngineNames(), 0));
+        
+        // The parametric bands start out off, with their frequencies spread evenly
+        // over the spectrum so that switching one on lands somewhere sensible.
+        constexpr auto numParametricBands = BandDesign::maxBands - BandDesign::numFixedBands;
+        
+        for (int band = BandDesign::numFixedBands; band < BandDesign::maxBands; ++band)
+        {
+            auto& bandIDs = ids[(size_t) band];
+            auto position = (float) (band - BandDesign::numFixedBands) + 0.5f;
+            auto defaultFreq = (float) juce::roundToInt(20.f * std::pow(1000.f, position / (float) numParametricBands));
+            
+            layout.add(std::make_unique<juce::AudioParameterChoice>(bandIDs.type, bandIDs.type, BandDesign::getTypeNames(), 0));
+            
+            layout.add(std::make_unique<juce::AudioParameterFloat>(bandIDs.freq, bandIDs.freq, juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), defaultFreq));
+            
+            layout.add(std::make_unique<juce::AudioParameterFloat>(bandIDs.gain, bandIDs.gain, juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
+            
+            layout.add(std::make_unique<juce::AudioParameterFloat>(bandIDs.quality, bandIDs.quality, juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.0f));
+            
+            layout.add(std::make_unique<juce::AudioParameterChoice>(bandIDs.slope, bandIDs.slope, stringArray, 0));
+            
+            layout.add(std::make_unique<juce::AudioParameterChoice>(bandIDs.engine, bandIDs.engine, BandDesign::getEngineNames(), 0));
+        }
+    }
+}
+
 //==============================================================================
 SimpleEQAudioProcessor::SimpleEQAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -16,16 +117,25 @@ SimpleEQAudioProcessor::SimpleEQAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
                        )
 #endif
 {
+    for (auto* param : getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            apvst.addParameterListener (paramWithID->paramID, this);
 }
 
 SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
 {
+    cancelPendingUpdate();
+    
+    for (auto* param : getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            apvst.removeParameterListener (paramWithID->paramID, this);
 }
 
 //==============================================================================
@@ -63,7 +173,10 @@ bool SimpleEQAudioProcessor::isMidiEffect() const
 
 double SimpleEQAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    if (apvst.getRawParameterValue("Phase Mode")->load() > 0.5f)
+        return getSampleRate() > 0.0 ? linearPhaseEQ.getTailLengthInSamples() / getSampleRate() : 0.0;
+    
+    return isUsingDoublePrecision() ? doubleChain.getTailLengthSeconds() : floatChain.getTailLengthSeconds();
 }
 
 int SimpleEQAudioProcessor::getNumPrograms()
@@ -95,27 +208,25 @@ void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
-    juce::dsp::ProcessSpec spec;
-    
-    spec.maximumBlockSize = samplesPerBlock;
+    auto numChannels = (size_t) juce::jmax(1, getMainBusNumInputChannels(), getMainBusNumOutputChannels());
     
-    spec.numChannels = 1;
+    // Hosts pick the precision before calling this, so the other chain can go.
+    withActiveChain([&] (auto& chain) { chain.prepare(sampleRate, (size_t) samplesPerBlock, numChannels); });
     
-    spec.sampleRate = sampleRate;
+    if (isUsingDoublePrecision())
+        floatChain.release();
+    else
+        doubleChain.release();
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    linearPhaseEQ.prepare(sampleRate, (int) numChannels);
     
-    auto chainSettings = getChainSettings(apvst);
+    // Force the processing mode, and with it the latency, to be picked up again.
+    oversamplingOrder = oversamplingFilter = channelMode = -1;
     
-    auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                                                                                chainSettings.peakFreq,
-                                                                                chainSettings.peakQuality,
-                                                                                juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
-    
-    *leftChain.get<ChainPositions::peak>().coefficients = *peakCoefficients;
-    *rightChain.get<ChainPositions::peak>().coefficients = *peakCoefficients;
+    updateFilters();
+    parametersChanged = false;
     
+    updateLatency();
 }
 
 void SimpleEQAudioProcessor::releaseResources()
@@ -131,12 +242,10 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel gets the same filtering, so any layout works as long as
+    // the main bus is enabled. The sidechain only feeds the dynamic band's
+    // detector, so it can be anything too.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
@@ -150,7 +259,23 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 }
 #endif
 
-void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    process(buffer, floatChain);
+}
+
+void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    process(buffer, doubleChain);
+}
+
+bool SimpleEQAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+void SimpleEQAudioProcessor::process (juce::AudioBuffer<SampleType>& buffer, EQChain<SampleType>& chain)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -165,25 +290,41 @@ void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    auto chainSettings = getChainSettings(apvst);
-    
-    auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(getSampleRate() ,
-                                                                                chainSettings.peakFreq,
-                                                                                chainSettings.peakQuality,
-                                                                                juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+    if (parametersChanged.exchange (false))
+        updateFilters();
     
-    *leftChain.get<ChainPositions::peak>().coefficients = *peakCoefficients;
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
 
-    juce::dsp::AudioBlock<float> block(buffer);
+    preAnalyserFifo.push(mainBuffer);
     
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    // The host's buffer is processed in place in its own precision.
+    juce::dsp::AudioBlock<SampleType> block(mainBuffer);
     
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    if (linearPhase)
+    {
+        linearPhaseEQ.process(block);
+    }
+    else
+    {
+        // Left empty, and so never listened to, while the host has the sidechain off.
+        juce::AudioBuffer<SampleType> sidechainBuffer;
+        
+        if (auto* sidechainBus = getBus(true, 1); sidechainBus != nullptr && sidechainBus->isEnabled())
+            sidechainBuffer = getBusBuffer(buffer, true, 1);
+        
+        chain.process(block, juce::dsp::AudioBlock<const SampleType>(sidechainBuffer));
+    }
     
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    postAnalyserFifo.push(mainBuffer);
+}
+
+template <typename Callback>
+void SimpleEQAudioProcessor::withActiveChain (Callback&& callback)
+{
+    if (isUsingDoublePrecision())
+        callback(doubleChain);
+    else
+        callback(floatChain);
 }
  
 //==============================================================================
@@ -194,64 +335,238 @@ bool SimpleEQAudioProcessor::hasEditor() const
 
 juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
 {
-//    return new SimpleEQAudioProcessorEditor (*this);
-    return new juce::GenericAudioProcessorEditor(*this);
+    return new SimpleEQAudioProcessorEditor (*this);
 }
 
 //==============================================================================
 void SimpleEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    parameterState.save(destData);
 }
 
 void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    if (sizeInBytes <= 0 || parameterState.load(data, (size_t) sizeInBytes))
+        return;
+    
+    // Not our binary format, so it may be an APVTS state saved as XML.
+    if (auto xml = getXmlFromBinary(data, sizeInBytes))
+        if (xml->hasTagName(apvst.state.getType()))
+            apvst.replaceState(juce::ValueTree::fromXml(*xml));
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+void SimpleEQAudioProcessor::parameterChanged (const juce::String& parameterID, float)
+{
+    parametersChanged = true;
+    
+    if (parameterID == "Phase Mode" || parameterID == "Oversampling" || parameterID == "Oversampling Filter")
+        triggerAsyncUpdate();
+}
+
+void SimpleEQAudioProcessor::handleAsyncUpdate()
+{
+    linearPhaseEQ.setActive(apvst.getRawParameterValue("Phase Mode")->load() > 0.5f);
+    updateLatency();
+}
+
+void SimpleEQAudioProcessor::updateLatency()
+{
+    // Worked out from the parameters rather than the chain, which the audio
+    // thread may not have reconfigured yet.
+    if (apvst.getRawParameterValue("Phase Mode")->load() > 0.5f)
+    {
+        setLatencySamples(linearPhaseEQ.getLatencyInSamples());
+        return;
+    }
+    
+    auto order = static_cast<int>(apvst.getRawParameterValue("Oversampling")->load());
+    auto filter = static_cast<int>(apvst.getRawParameterValue("Oversampling Filter")->load());
+    
+    int latency = 0;
+    withActiveChain([&] (auto& chain) { latency = chain.getLatencyInSamples(order, filter); });
+    
+    setLatencySamples(latency);
+}
+
+void SimpleEQAudioProcessor::updateProcessingMode()
+{
+    auto newLinearPhase = apvst.getRawParameterValue("Phase Mode")->load() > 0.5f;
+    auto newOrder = static_cast<int>(apvst.getRawParameterValue("Oversampling")->load());
+    auto newFilter = static_cast<int>(apvst.getRawParameterValue("Oversampling Filter")->load());
+    
+    if (newLinearPhase == linearPhase && newOrder == oversamplingOrder && newFilter == oversamplingFilter)
+        return;
+    
+    linearPhase = newLinearPhase;
+    oversamplingOrder = newOrder;
+    oversamplingFilter = newFilter;
+    
+    // The filter state was built up at a different rate or in another mode, so
+    // start again from silence. The linear phase kernel is designed without
+    // cramping, so it always runs at 1x.
+    withActiveChain([&] (auto& chain)
+    {
+        chain.setOversampling(linearPhase ? 0 : oversamplingOrder, oversamplingFilter);
+    });
+    
+    linearPhaseEQ.reset();
+}
+
+double SimpleEQAudioProcessor::getDesignSampleRate() const
+{
+    if (apvst.getRawParameterValue("Phase Mode")->load() > 0.5f)
+        return getSampleRate() * LinearPhaseEQ::designOversampling;
+    
+    return getSampleRate() * (double) (1 << static_cast<int>(apvst.getRawParameterValue("Oversampling")->load()));
+}
+
+void SimpleEQAudioProcessor::updateFilters()
+{
+    updateProcessingMode();
+    
+    if (linearPhase)
+        linearPhaseEQ.requestKernelUpdate();
+    
+    auto newChannelMode = static_cast<int>(apvst.getRawParameterValue("Channel Mode")->load());
+    
+    if (newChannelMode != channelMode)
+    {
+        channelMode = newChannelMode;
+        withActiveChain([&] (auto& chain) { chain.setChannelMode(static_cast<ChannelMode>(channelMode)); });
+    }
+    
+    std::array<ChainSettings, numParameterSets> chainSettings;
+    
+    for (size_t set = 0; set < numParameterSets; ++set)
+        chainSettings[set] = getChainSettings(apvst, set);
+    
+    withActiveChain([&] (auto& chain)
+    {
+        for (size_t set = 0; set < numParameterSets; ++set)
+            chain.setTargetBands(chainSettings[set], set);
+    });
+}
+
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts, size_t set)
 {
     ChainSettings settings;
+    auto& ids = getBandParameterIDs(set);
+    
+    auto& lowCut = settings.bands[ChainSettings::LowCut];
+    auto& lowCutIDs = ids[ChainSettings::LowCut];
+    lowCut.type = BandType::LowCut;
+    lowCut.frequency = apvts.getRawParameterValue(lowCutIDs.freq)->load();
+    lowCut.slope = static_cast<Slope>(static_cast<int>(apvts.getRawParameterValue(lowCutIDs.slope)->load()));
+    lowCut.engine = static_cast<BandEngine>(static_cast<int>(apvts.getRawParameterValue(lowCutIDs.engine)->load()));
+    
+    auto& peak = settings.bands[ChainSettings::Peak];
+    auto& peakIDs = ids[ChainSettings::Peak];
+    peak.type = BandType::Bell;
+    peak.frequency = apvts.getRawParameterValue(peakIDs.freq)->load();
+    peak.gainInDecibels = apvts.getRawParameterValue(peakIDs.gain)->load();
+    peak.quality = apvts.getRawParameterValue(peakIDs.quality)->load();
+    peak.engine = static_cast<BandEngine>(static_cast<int>(apvts.getRawParameterValue(peakIDs.engine)->load()));
+    
+    auto& dynamics = settings.dynamics;
+    dynamics.mode = static_cast<DynamicsMode>(static_cast<int>(apvts.getRawParameterValue("Peak Dynamics")->load()));
+    dynamics.thresholdInDecibels = apvts.getRawParameterValue("Peak Threshold")->load();
+    dynamics.ratio = apvts.getRawParameterValue("Peak Ratio")->load();
+    dynamics.rangeInDecibels = apvts.getRawParameterValue("Peak Range")->load();
+    dynamics.attackInMilliseconds = apvts.getRawParameterValue("Peak Attack")->load();
+    dynamics.releaseInMilliseconds = apvts.getRawParameterValue("Peak Release")->load();
     
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope = apvts.getRawParameterValue("LowCut Slope")->load();
-    settings.highCutSlope = apvts.getRawParameterValue("HighCut Slope")->load();
+    auto& highCut = settings.bands[ChainSettings::HighCut];
+    auto& highCutIDs = ids[ChainSettings::HighCut];
+    highCut.type = BandType::HighCut;
+    highCut.frequency = apvts.getRawParameterValue(highCutIDs.freq)->load();
+    highCut.slope = static_cast<Slope>(static_cast<int>(apvts.getRawParameterValue(highCutIDs.slope)->load()));
+    highCut.engine = static_cast<BandEngine>(static_cast<int>(apvts.getRawParameterValue(highCutIDs.engine)->load()));
+    
+    for (int band = BandDesign::numFixedBands; band < BandDesign::maxBands; ++band)
+    {
+        auto& bandIDs = ids[(size_t) band];
+        auto& settingsForBand = settings.bands[(size_t) band];
+        
+        settingsForBand.type = static_cast<BandType>(static_cast<int>(apvts.getRawParameterValue(bandIDs.type)->load()));
+        settingsForBand.frequency = apvts.getRawParameterValue(bandIDs.freq)->load();
+        settingsForBand.gainInDecibels = apvts.getRawParameterValue(bandIDs.gain)->load();
+        settingsForBand.quality = apvts.getRawParameterValue(bandIDs.quality)->load();
+        settingsForBand.slope = static_cast<Slope>(static_cast<int>(apvts.getRawParameterValue(bandIDs.slope)->load()));
+        settingsForBand.engine = static_cast<BandEngine>(static_cast<int>(apvts.getRawParameterValue(bandIDs.engine)->load()));
+    }
     
     return settings;
 }
 
+void setChainSettings(juce::AudioProcessorValueTreeState& apvts, const ChainSettings& settings, size_t set)
+{
+    auto setValue = [&apvts](const juce::String& paramID, float value)
+    {
+        // The fixed bands have no parameter for some settings, and leave those IDs empty.
+        if (paramID.isEmpty())
+            return;
+        
+        if (auto* parameter = apvts.getParameter(paramID))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    };
+    
+    auto& ids = getBandParameterIDs(set);
+    
+    for (size_t band = 0; band < ids.size(); ++band)
+    {
+        auto& bandIDs = ids[band];
+        auto& bandSettings = settings.bands[band];
+        
+        setValue(bandIDs.type, (float) static_cast<int>(bandSettings.type));
+        setValue(bandIDs.freq, bandSettings.frequency);
+        setValue(bandIDs.gain, bandSettings.gainInDecibels);
+        setValue(bandIDs.quality, bandSettings.quality);
+        setValue(bandIDs.slope, (float) static_cast<int>(bandSettings.slope));
+        setValue(bandIDs.engine, (float) static_cast<int>(bandSettings.engine));
+    }
+    
+    if (set == 0)
+    {
+        auto& dynamics = settings.dynamics;
+        setValue("Peak Dynamics", (float) static_cast<int>(dynamics.mode));
+        setValue("Peak Threshold", dynamics.thresholdInDecibels);
+        setValue("Peak Ratio", dynamics.ratio);
+        setValue("Peak Range", dynamics.rangeInDecibels);
+        setValue("Peak Attack", dynamics.attackInMilliseconds);
+        setValue("Peak Release", dynamics.releaseInMilliseconds);
+    }
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::createParameterLayout()
 {
         juce::AudioProcessorValueTreeState::ParameterLayout layout;
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>("LowCut Freq", "LowCut freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f), 20.f));
+        addBandParameters(layout, 0);
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>("HighCut Freq", "HighCut freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f), 20000.f));
+        // Dynamics only run in minimum phase mode, as the linear phase kernel is fixed.
+        layout.add(std::make_unique<juce::AudioParameterChoice>("Peak Dynamics", "Peak Dynamics", juce::StringArray { "Off", "Band", "Sidechain" }, 0));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Freq", "Peak freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f), 750.f));
+        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Threshold", "Peak Threshold", juce::NormalisableRange<float>(-60.f, 0.f, 0.5f, 1.f), -24.f));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Gain", "Peak Gain", juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), 0.0f));
+        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Ratio", "Peak Ratio", juce::NormalisableRange<float>(1.f, 20.f, 0.1f, 0.4f), 2.f));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Quality", "Peak Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.0f));
+        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Range", "Peak Range", juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f), -12.f));
         
-        juce::StringArray stringArray;
-        for(int i = 0; i < 4; i++){
-            juce::String str;
-            str << (12+i*12);
-            str << " db/Oct";
-            stringArray.add(str);
-        }
+        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Attack", "Peak Attack", juce::NormalisableRange<float>(0.1f, 200.f, 0.1f, 0.4f), 10.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Release", "Peak Release", juce::NormalisableRange<float>(5.f, 2000.f, 1.f, 0.4f), 150.f));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>("Phase Mode", "Phase Mode", juce::StringArray { "Minimum Phase", "Linear Phase" }, 0));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>("Oversampling", "Oversampling", juce::StringArray { "1x", "2x", "4x", "8x" }, 0));
+        
+        layout.add(std::make_unique<juce::AudioParameterChoice>("Oversampling Filter", "Oversampling Filter", juce::StringArray { "IIR (Low Latency)", "FIR (Linear Phase)" }, 0));
         
-        layout.add(std::make_unique<juce::AudioParameterChoice>("LowCut Slope", "LowCut Slope", stringArray, 0));
+        // Like dynamics, the split modes only run in minimum phase mode. The second
+        // set of bands drives the side channel, or the right one in dual mono.
+        layout.add(std::make_unique<juce::AudioParameterChoice>("Channel Mode", "Channel Mode", juce::StringArray { "Stereo", "Mid/Side", "Dual Mono" }, 0));
         
-        layout.add(std::make_unique<juce::AudioParameterChoice>("HighCut Slope", "HighCut Slope", stringArray, 0));
+        addBandParameters(layout, 1);
         
         return layout;
     }
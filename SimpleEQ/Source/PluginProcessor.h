@@ -9,20 +9,27 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "EQChain.h"
+#include "LinearPhaseEQ.h"
+#include "AnalyserFifo.h"
+#include "ParameterState.h"
 
-struct ChainSettings
-{
-    float peakFreq {0}, peakGainInDecibels{0}, peakQuality {1.f};
-    float lowCutFreq {0}, highCutFreq {0};
-    int lowCutSlope {0}, highCutSlope {0};
-};
+/** Reads one parameter set's bands: 0 for the main set, 1 for the set that drives
+    the side or right channel in the split channel modes.
+*/
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts, size_t set = 0);
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+/** The reverse of getChainSettings(): writes every band of settings, and for set 0
+    the Peak band's dynamics too, into the parameters, notifying the host.
+*/
+void setChainSettings(juce::AudioProcessorValueTreeState& apvts, const ChainSettings& settings, size_t set = 0);
 
 //==============================================================================
 /**
 */
-class SimpleEQAudioProcessor  : public juce::AudioProcessor
+class SimpleEQAudioProcessor  : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::AsyncUpdater
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -41,6 +48,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -66,21 +75,57 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvst {*this, nullptr, "Parameters",createParameterLayout()};
+    
+    /** The rate the filters are currently designed at, taking the phase mode and
+        oversampling into account. Only reads parameters, so any thread may call it.
+    */
+    double getDesignSampleRate() const;
+    
+    /** What went into and came out of the EQ, for the editor's spectrum analyser. */
+    AnalyserFifo preAnalyserFifo, postAnalyserFifo;
 
 private:
-    using Filter = juce::dsp::IIR::Filter<float>;
-        
-    using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+    //==============================================================================
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+    
+    /** Reports the latency of the mode the parameters ask for, and starts or
+        stops the linear phase kernel designer to match. Hosts may react to a
+        latency change by calling straight back into the plugin, so this runs on
+        the message thread, triggered when a mode parameter changes.
+    */
+    void handleAsyncUpdate() override;
+    void updateLatency();
+
+    /** Hands the current parameter values to the active chain, which glides to
+        them on its control grid. Called on the audio thread only when a
+        parameter has changed since the last block.
+    */
+    void updateFilters();
+    
+    /** Reconfigures the chain for the phase mode and oversampling. The latency
+        is reported separately, by updateLatency().
+    */
+    void updateProcessingMode();
+    
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>& buffer, EQChain<SampleType>& chain);
+    
+    /** Calls callback with whichever chain matches the current processing precision. */
+    template <typename Callback>
+    void withActiveChain (Callback&& callback);
     
-    using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+    // Only the chain matching the host's processing precision is prepared.
+    EQChain<float> floatChain;
+    EQChain<double> doubleChain;
+    int oversamplingOrder = -1, oversamplingFilter = -1, channelMode = -1;
     
-    MonoChain leftChain,rightChain;
+    LinearPhaseEQ linearPhaseEQ { apvst };
+    ParameterState parameterState { apvst };
+    bool linearPhase = false;
     
-    enum ChainPositions{
-        LowCut,
-        peak,
-        HighCut
-    };
+    // Set by the APVTS listener on whichever thread changed a parameter, and
+    // consumed at the top of processBlock.
+    std::atomic<bool> parametersChanged { true };
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
 };
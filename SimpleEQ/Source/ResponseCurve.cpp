@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 17 Oct 2026 4:02:36pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+#include "FilterResponse.h"
+#include "SpectrumAnalyser.h"
+
+ResponseCurve::ResponseCurve (SimpleEQAudioProcessor& p)
+    : audioProcessor (p)
+{
+    // Same frequency axis as the analyser, so the two line up.
+    for (size_t i = 0; i < numPoints; ++i)
+        frequencies[i] = juce::mapToLog10 ((double) i / (double) (numPoints - 1),
+                                           (double) SpectrumAnalyser::minFrequency,
+                                           (double) SpectrumAnalyser::maxFrequency);
+
+    for (auto* param : audioProcessor.getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            audioProcessor.apvst.addParameterListener (paramWithID->paramID, this);
+
+    setInterceptsMouseClicks (false, false);
+    startTimerHz (60);
+}
+
+ResponseCurve::~ResponseCurve()
+{
+    for (auto* param : audioProcessor.getParameters())
+        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*> (param))
+            audioProcessor.apvst.removeParameterListener (paramWithID->paramID, this);
+}
+
+//==============================================================================
+void ResponseCurve::paint (juce::Graphics& g)
+{
+    const std::array<juce::Colour, 2> colours { juce::Colours::orange, juce::Colours::skyblue };
+
+    for (size_t set = 0; set < numCurves; ++set)
+    {
+        g.setColour (colours[set]);
+        g.strokePath (responsePaths[set], juce::PathStrokeType (2.0f));
+    }
+}
+
+void ResponseCurve::resized()
+{
+    updatePaths();
+}
+
+void ResponseCurve::parameterChanged (const juce::String&, float)
+{
+    parametersChanged = true;
+}
+
+void ResponseCurve::timerCallback()
+{
+    if (parametersChanged.exchange (false))
+    {
+        updateMagnitudes();
+        updatePaths();
+        repaint();
+    }
+}
+
+//==============================================================================
+void ResponseCurve::updateMagnitudes()
+{
+    auto& apvts = audioProcessor.apvst;
+    auto designSampleRate = audioProcessor.getDesignSampleRate();
+
+    // As in the processor, the split modes only run in minimum phase mode.
+    auto isSplit = apvts.getRawParameterValue ("Channel Mode")->load() > 0.5f
+                && apvts.getRawParameterValue ("Phase Mode")->load() < 0.5f;
+
+    numCurves = isSplit ? magnitudes.size() : 1;
+
+    for (size_t set = 0; set < numCurves; ++set)
+    {
+        magnitudes[set].fill (1.0);
+
+        if (designSampleRate > 0.0)
+            FilterResponse::applyChainMagnitudes (getChainSettings (apvts, set), designSampleRate,
+                                                  frequencies.data(), magnitudes[set].data(), numPoints);
+    }
+}
+
+void ResponseCurve::updatePaths()
+{
+    auto width = (float) getWidth();
+    auto height = (float) getHeight();
+
+    for (size_t set = 0; set < numCurves; ++set)
+    {
+        auto& path = responsePaths[set];
+        path.clear();
+
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            auto x = width * (float) i / (float) (numPoints - 1);
+            auto decibels = juce::Decibels::gainToDecibels ((float) magnitudes[set][i], minDecibels * 2.0f);
+            auto y = juce::jmap (decibels, minDecibels, maxDecibels, height, 0.0f);
+
+            if (i == 0)
+                path.startNewSubPath (x, y);
+            else
+                path.lineTo (x, y);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 17 Oct 2026 4:02:36pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+    Draws the combined magnitude response of the EQ. In Mid/Side and Dual Mono
+    the second parameter set, which drives the side or right channel, gets a
+    curve of its own.
+
+    The response is evaluated at numPoints log-spaced frequencies, only after a
+    parameter has changed, and kept as a Path. Resizing just rescales the cached
+    magnitudes and paint() only strokes the path, so nothing is evaluated per
+    pixel or per repaint.
+*/
+class ResponseCurve  : public juce::Component,
+                       private juce::AudioProcessorValueTreeState::Listener,
+                       private juce::Timer
+{
+public:
+    explicit ResponseCurve (SimpleEQAudioProcessor&);
+    ~ResponseCurve() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    static constexpr float minDecibels = -24.0f, maxDecibels = 24.0f;
+
+private:
+    //==============================================================================
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+    void timerCallback() override;
+
+    void updateMagnitudes();
+    void updatePaths();
+
+    static constexpr size_t numPoints = 512;
+
+    SimpleEQAudioProcessor& audioProcessor;
+
+    std::array<double, numPoints> frequencies {};
+
+    // One per parameter set; the second is only drawn when the channels are split.
+    std::array<std::array<double, numPoints>, EQChain<float>::maxParameterSets> magnitudes {};
+    std::array<juce::Path, EQChain<float>::maxParameterSets> responsePaths;
+    size_t numCurves = 1;
+
+    // Set from whichever thread changed a parameter; picked up by the timer.
+    std::atomic<bool> parametersChanged { true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurve)
+};
@@ -0,0 +1,339 @@
+/*
+  ==============================================================================
+
+    SVFBank.h
+    Created: 17 Oct 2026 7:44:31pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A fixed-capacity bank of trapezoidal (TPT) state variable filters, after
+    Andrew Simper's "linear trap optimised" SVF, stored as a structure of arrays
+    like BiquadBank.
+
+    Each slot is described by its prewarped cutoff g, damping k and the mix
+    m0 * input + m1 * band + m2 * low, so one structure gives every band shape.
+    The topology stays stable for any positive g and k, which means coefficients
+    can move on every sample: startRamp() glides g, k and the mix linearly to new
+    targets, one small step per sample. The 1 / (1 + g (g + k)) the filter needs
+    is tracked with one Newton step per sample rather than a divide, and is
+    recomputed exactly whenever a ramp starts or ends.
+*/
+template <typename SampleType, size_t MaxStages>
+class SVFBank
+{
+public:
+    using NumericType = typename juce::dsp::SampleTypeHelpers::ElementType<SampleType>::Type;
+
+    struct Coefficients
+    {
+        NumericType g, k, m0, m1, m2;
+    };
+
+    //==============================================================================
+    void prepare (const juce::dsp::ProcessSpec&) noexcept    { reset(); }
+
+    void reset() noexcept
+    {
+        ic1.fill (broadcast (0));
+        ic2.fill (broadcast (0));
+    }
+
+    /** Sets where a slot's coefficients should go on the next ramp, or puts them
+        there straight away if jump is true.
+    */
+    void setCoefficients (size_t slot, const Coefficients& c, bool jump) noexcept
+    {
+        jassert (slot < MaxStages);
+
+        target[G][slot] = broadcast (c.g);
+        target[K][slot] = broadcast (c.k);
+        target[M0][slot] = broadcast (c.m0);
+        target[M1][slot] = broadcast (c.m1);
+        target[M2][slot] = broadcast (c.m2);
+
+        if (jump)
+            jumpToTarget (slot);
+    }
+
+    /** Like setCoefficients(), but only for one lane of the slot. A jump still
+        lands every lane of the slot on its target.
+    */
+    void setLaneCoefficients (size_t slot, size_t lane, const Coefficients& c, bool jump) noexcept
+    {
+        jassert (slot < MaxStages);
+
+        setLane (target[G][slot], lane, c.g);
+        setLane (target[K][slot], lane, c.k);
+        setLane (target[M0][slot], lane, c.m0);
+        setLane (target[M1][slot], lane, c.m1);
+        setLane (target[M2][slot], lane, c.m2);
+
+        if (jump)
+            jumpToTarget (slot);
+    }
+
+    /** Glides every active slot from wherever it is now to its target over the
+        next numSamples processed samples.
+    */
+    void startRamp (size_t numSamples) noexcept
+    {
+        if (numSamples == 0)
+        {
+            for (size_t i = 0; i < numActive; ++i)
+                jumpToTarget (activeSlots[i]);
+
+            rampRemaining = 0;
+            return;
+        }
+
+        auto scale = static_cast<NumericType> (1) / static_cast<NumericType> (numSamples);
+
+        for (size_t i = 0; i < numActive; ++i)
+        {
+            auto slot = activeSlots[i];
+
+            for (size_t p = 0; p < numParameters; ++p)
+                increment[p][slot] = (target[p][slot] - current[p][slot]) * scale;
+
+            a1[slot] = computeA1 (current[G][slot], current[K][slot]);
+        }
+
+        rampRemaining = numSamples;
+    }
+
+    /** Replaces the list of slots to run. Slots joining the list are cleared first,
+        as they still hold whatever they last rang with.
+    */
+    void setActiveSlots (const juce::uint16* slots, size_t numSlots) noexcept
+    {
+        jassert (numSlots <= MaxStages);
+
+        std::array<bool, MaxStages> wasActive {};
+
+        for (size_t i = 0; i < numActive; ++i)
+            wasActive[activeSlots[i]] = true;
+
+        for (size_t i = 0; i < numSlots; ++i)
+        {
+            if (! wasActive[slots[i]])
+            {
+                ic1[slots[i]] = broadcast (0);
+                ic2[slots[i]] = broadcast (0);
+            }
+
+            activeSlots[i] = slots[i];
+        }
+
+        numActive = numSlots;
+    }
+
+    size_t getNumActiveSlots() const noexcept    { return numActive; }
+
+    /** True if the state of every active slot, on every lane, is within threshold
+        of zero.
+    */
+    bool isStateBelow (NumericType threshold) const noexcept
+    {
+        auto largest = broadcast (0);
+
+        for (size_t i = 0; i < numActive; ++i)
+            largest = max (largest, max (abs (ic1[activeSlots[i]]), abs (ic2[activeSlots[i]])));
+
+        if constexpr (std::is_floating_point<SampleType>::value)
+        {
+            return largest <= threshold;
+        }
+        else
+        {
+            for (size_t lane = 0; lane < SampleType::size(); ++lane)
+                if (largest.get (lane) > threshold)
+                    return false;
+
+            return true;
+        }
+    }
+
+    //==============================================================================
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                       "The sample type of the context must match the sample type of the filter");
+
+        auto&& outputBlock = context.getOutputBlock();
+
+        // The stages run one after the other in place on the output block.
+        jassert (! context.usesSeparateInputAndOutputBlocks());
+        jassert (outputBlock.getNumChannels() == 1);
+
+        if (context.isBypassed)
+            return;
+
+        processSamples (outputBlock.getChannelPointer (0), outputBlock.getNumSamples());
+    }
+
+    void processSamples (SampleType* data, size_t numSamples) noexcept
+    {
+        auto numRampSamples = juce::jmin (numSamples, rampRemaining);
+
+        for (size_t i = 0; i < numActive; ++i)
+            processSlot (activeSlots[i], data, numSamples, numRampSamples);
+
+        if (numRampSamples > 0)
+        {
+            rampRemaining -= numRampSamples;
+
+            // Land exactly on the targets rather than wherever the steps summed to.
+            if (rampRemaining == 0)
+                for (size_t i = 0; i < numActive; ++i)
+                    jumpToTarget (activeSlots[i]);
+        }
+    }
+
+private:
+    enum Parameter { G, K, M0, M1, M2, numParameters };
+
+    void processSlot (size_t slot, SampleType* data, size_t numSamples, size_t numRampSamples) noexcept
+    {
+        auto g = current[G][slot], k = current[K][slot];
+        auto m0 = current[M0][slot], m1 = current[M1][slot], m2 = current[M2][slot];
+        auto la1 = a1[slot];
+        auto s1 = ic1[slot], s2 = ic2[slot];
+        auto two = broadcast (2), one = broadcast (1);
+
+        size_t i = 0;
+
+        if (numRampSamples > 0)
+        {
+            auto dg = increment[G][slot], dk = increment[K][slot];
+            auto dm0 = increment[M0][slot], dm1 = increment[M1][slot], dm2 = increment[M2][slot];
+
+            for (; i < numRampSamples; ++i)
+            {
+                g = g + dg;
+                k = k + dk;
+                m0 = m0 + dm0;
+                m1 = m1 + dm1;
+                m2 = m2 + dm2;
+
+                // One Newton step towards 1 / (1 + g (g + k)) from last sample's value.
+                la1 = la1 * (two - (one + g * (g + k)) * la1);
+
+                data[i] = tick (data[i], la1, g, m0, m1, m2, s1, s2);
+            }
+
+            current[G][slot] = g;
+            current[K][slot] = k;
+            current[M0][slot] = m0;
+            current[M1][slot] = m1;
+            current[M2][slot] = m2;
+            a1[slot] = la1;
+        }
+
+        for (; i < numSamples; ++i)
+            data[i] = tick (data[i], la1, g, m0, m1, m2, s1, s2);
+
+        ic1[slot] = s1;
+        ic2[slot] = s2;
+    }
+
+    static SampleType tick (SampleType v0, SampleType la1, SampleType g,
+                            SampleType m0, SampleType m1, SampleType m2,
+                            SampleType& s1, SampleType& s2) noexcept
+    {
+        auto la2 = g * la1;
+        auto la3 = g * la2;
+
+        auto v3 = v0 - s2;
+        auto v1 = la1 * s1 + la2 * v3;
+        auto v2 = s2 + la2 * s1 + la3 * v3;
+
+        s1 = v1 + v1 - s1;
+        s2 = v2 + v2 - s2;
+
+        return m0 * v0 + m1 * v1 + m2 * v2;
+    }
+
+    void jumpToTarget (size_t slot) noexcept
+    {
+        for (size_t p = 0; p < numParameters; ++p)
+        {
+            current[p][slot] = target[p][slot];
+            increment[p][slot] = broadcast (0);
+        }
+
+        a1[slot] = computeA1 (current[G][slot], current[K][slot]);
+    }
+
+    static SampleType computeA1 (SampleType g, SampleType k) noexcept
+    {
+        auto denominator = broadcast (1) + g * (g + k);
+
+        if constexpr (std::is_floating_point<SampleType>::value)
+        {
+            return static_cast<NumericType> (1) / denominator;
+        }
+        else
+        {
+            // SIMDRegister has no divide, and this only runs when a ramp starts or ends.
+            SampleType result;
+
+            for (size_t lane = 0; lane < SampleType::size(); ++lane)
+                result.set (lane, static_cast<NumericType> (1) / denominator.get (lane));
+
+            return result;
+        }
+    }
+
+    static SampleType abs (SampleType x) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+            return std::abs (x);
+        else
+            return SampleType::abs (x);
+    }
+
+    static SampleType max (SampleType a, SampleType b) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+            return juce::jmax (a, b);
+        else
+            return SampleType::max (a, b);
+    }
+
+    static void setLane (SampleType& column, size_t lane, NumericType value) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+        {
+            jassertquiet (lane == 0);
+            column = value;
+        }
+        else
+        {
+            column.set (lane, value);
+        }
+    }
+
+    static SampleType broadcast (NumericType value) noexcept
+    {
+        if constexpr (std::is_floating_point<SampleType>::value)
+            return value;
+        else
+            return SampleType::expand (value);
+    }
+
+    using Column = std::array<SampleType, MaxStages>;
+
+    std::array<Column, numParameters> current, target, increment;
+    Column a1, ic1, ic2;
+    std::array<juce::uint16, MaxStages> activeSlots {};
+    size_t numActive = 0, rampRemaining = 0;
+};
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 17 Oct 2026 3:18:27pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+SpectrumAnalyser::SpectrumAnalyser (SimpleEQAudioProcessor& p)
+    : juce::Thread ("Spectrum analyser"),
+      audioProcessor (p),
+      pre (p.preAnalyserFifo),
+      post (p.postAnalyserFifo)
+{
+    // Full-scale sine -> 0 dB, allowing for the energy the window takes away.
+    std::array<float, fftSize> windowTable;
+    windowTable.fill (1.0f);
+    window.multiplyWithWindowingTable (windowTable.data(), (size_t) fftSize);
+
+    auto windowSum = std::accumulate (windowTable.begin(), windowTable.end(), 0.0f);
+    magnitudeScale = 2.0f / windowSum;
+
+    for (auto* channel : { &pre, &post })
+    {
+        channel->decibels.fill (minDecibels);
+        channel->fifo.setEnabled (true);
+    }
+
+    setOpaque (false);
+    startThread();
+    startTimerHz (refreshRateHz);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    stopTimer();
+    stopThread (1000);
+
+    pre.fifo.setEnabled (false);
+    post.fifo.setEnabled (false);
+}
+
+//==============================================================================
+void SpectrumAnalyser::paint (juce::Graphics& g)
+{
+    const juce::ScopedLock sl (pathLock);
+
+    g.setColour (juce::Colours::skyblue.withAlpha (0.35f));
+    g.fillPath (prePath);
+
+    g.setColour (juce::Colours::white.withAlpha (0.8f));
+    g.strokePath (postPath, juce::PathStrokeType (1.5f));
+}
+
+void SpectrumAnalyser::resized()
+{
+    width = (float) getWidth();
+    height = (float) getHeight();
+}
+
+void SpectrumAnalyser::timerCallback()
+{
+    if (newPathsReady.exchange (false))
+        repaint();
+}
+
+//==============================================================================
+void SpectrumAnalyser::run()
+{
+    while (! threadShouldExit())
+    {
+        auto preChanged = pre.update (fft, window, magnitudeScale);
+        auto postChanged = post.update (fft, window, magnitudeScale);
+
+        if (preChanged || postChanged)
+        {
+            auto sampleRate = audioProcessor.getSampleRate();
+            auto newPrePath = pre.createPath (sampleRate, width, height);
+            auto newPostPath = post.createPath (sampleRate, width, height);
+
+            // Close the pre path along the bottom so it can be filled.
+            if (! newPrePath.isEmpty())
+            {
+                newPrePath.lineTo (width.load(), height.load());
+                newPrePath.lineTo (0.0f, height.load());
+                newPrePath.closeSubPath();
+            }
+
+            {
+                const juce::ScopedLock sl (pathLock);
+                prePath.swapWithPath (newPrePath);
+                postPath.swapWithPath (newPostPath);
+            }
+
+            newPathsReady = true;
+        }
+
+        wait (1000 / refreshRateHz);
+    }
+}
+
+bool SpectrumAnalyser::Channel::update (juce::dsp::FFT& fftToUse, juce::dsp::WindowingFunction<float>& windowToUse, float scale)
+{
+    auto numRead = fifo.pull (incoming.data(), (int) incoming.size());
+
+    if (numRead == 0)
+        return false;
+
+    for (int i = 0; i < numRead; ++i)
+    {
+        history[(size_t) historyPosition] = incoming[(size_t) i];
+        historyPosition = (historyPosition + 1) % fftSize;
+    }
+
+    // Unroll the history so the oldest sample comes first.
+    auto oldest = history.begin() + historyPosition;
+    std::rotate_copy (history.begin(), oldest, history.end(), fftData.begin());
+    std::fill (fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    windowToUse.multiplyWithWindowingTable (fftData.data(), (size_t) fftSize);
+    fftToUse.performFrequencyOnlyForwardTransform (fftData.data(), true);
+
+    for (size_t bin = 0; bin < decibels.size(); ++bin)
+    {
+        auto level = juce::Decibels::gainToDecibels (fftData[bin] * scale, minDecibels);
+
+        // Instant attack, smooth release.
+        decibels[bin] = level > decibels[bin] ? level : decibels[bin] + (level - decibels[bin]) * 0.2f;
+    }
+
+    return true;
+}
+
+juce::Path SpectrumAnalyser::Channel::createPath (double sampleRate, float w, float h) const
+{
+    juce::Path path;
+
+    if (w <= 0.0f || h <= 0.0f || sampleRate <= 0.0)
+        return path;
+
+    auto binWidth = (float) (sampleRate / fftSize);
+    auto lastX = -1.0f;
+    auto lowestY = h;
+
+    // Bins crowd together at the top of a log axis, so only the loudest bin that
+    // lands on each pixel column makes it into the path.
+    for (size_t bin = 1; bin < decibels.size(); ++bin)
+    {
+        auto frequency = (float) bin * binWidth;
+
+        if (frequency < minFrequency)
+            continue;
+
+        if (frequency > maxFrequency)
+            break;
+
+        auto x = std::floor (juce::mapFromLog10 (frequency, minFrequency, maxFrequency) * w);
+        auto y = juce::jmap (decibels[bin], minDecibels, maxDecibels, h, 0.0f);
+
+        if (x == lastX)
+        {
+            lowestY = juce::jmin (lowestY, y);
+            continue;
+        }
+
+        if (lastX >= 0.0f)
+        {
+            if (path.isEmpty())
+                path.startNewSubPath (lastX, lowestY);
+            else
+                path.lineTo (lastX, lowestY);
+        }
+
+        lastX = x;
+        lowestY = y;
+    }
+
+    if (! path.isEmpty())
+        path.lineTo (lastX, lowestY);
+
+    return path;
+}
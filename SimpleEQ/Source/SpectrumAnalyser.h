@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 17 Oct 2026 3:18:27pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+    Draws the pre- and post-EQ spectra of a SimpleEQAudioProcessor.
+
+    A background thread drains the processor's analyser fifos, runs the windowed
+    FFTs and builds the log-frequency paths. The message thread only swaps in
+    finished paths and repaints, at most refreshRateHz times a second. The fifos
+    are only enabled while one of these exists, so a closed editor costs the audio
+    thread nothing.
+*/
+class SpectrumAnalyser  : public juce::Component,
+                          private juce::Thread,
+                          private juce::Timer
+{
+public:
+    explicit SpectrumAnalyser (SimpleEQAudioProcessor&);
+    ~SpectrumAnalyser() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    static constexpr float minFrequency = 20.0f, maxFrequency = 20000.0f;
+    static constexpr float minDecibels = -90.0f, maxDecibels = 12.0f;
+
+private:
+    //==============================================================================
+    void run() override;
+    void timerCallback() override;
+
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int refreshRateHz = 60;
+
+    struct Channel
+    {
+        explicit Channel (AnalyserFifo& fifoToUse) : fifo (fifoToUse) {}
+
+        /** Drains the fifo and, if anything new arrived, refreshes the spectrum. */
+        bool update (juce::dsp::FFT&, juce::dsp::WindowingFunction<float>&, float magnitudeScale);
+        juce::Path createPath (double sampleRate, float width, float height) const;
+
+        AnalyserFifo& fifo;
+        std::array<float, fftSize> history {};
+        std::array<float, fftSize * 2> fftData {};
+        std::array<float, fftSize / 2> decibels {};
+        std::vector<float> incoming = std::vector<float> (AnalyserFifo::capacity);
+        int historyPosition = 0;
+    };
+
+    SimpleEQAudioProcessor& audioProcessor;
+
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann };
+    float magnitudeScale = 1.0f;
+
+    Channel pre, post;
+
+    std::atomic<float> width { 0.0f }, height { 0.0f };
+
+    juce::CriticalSection pathLock;
+    juce::Path prePath, postPath;
+    std::atomic<bool> newPathsReady { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyser)
+};
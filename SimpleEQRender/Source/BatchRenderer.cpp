@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 17 Oct 2026 9:41:16pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+
+//==============================================================================
+class BatchRenderer::Worker  : public juce::Thread
+{
+public:
+    explicit Worker (BatchRenderer& r)
+        : juce::Thread ("SimpleEQ render worker"), renderer (r)
+    {
+        formatManager.registerBasicFormats();
+
+        processor.setNonRealtime (true);
+        processor.setStateInformation (renderer.options.state.getData(), (int) renderer.options.state.getSize());
+    }
+
+    ~Worker() override
+    {
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        for (auto index = renderer.nextFile++; index < renderer.inputs.size() && ! threadShouldExit(); index = renderer.nextFile++)
+            renderer.finishFile (renderFile (renderer.inputs.getReference (index).file, renderer.outputs[index]));
+    }
+
+private:
+    FileResult renderFile (const juce::File& input, const juce::File& output)
+    {
+        FileResult result;
+        result.input = input;
+        result.output = output;
+
+        if (output == juce::File())
+        {
+            result.error = "another input renders to the same output file";
+            return result;
+        }
+
+        auto startTime = juce::Time::getMillisecondCounterHiRes();
+        result.error = renderInto (input, result.output);
+
+        if (result.error.isNotEmpty() && result.output != input)
+            result.output.deleteFile();
+
+        result.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+        if (result.error.isEmpty())
+            result.audioSeconds = (double) lastLengthInSamples / lastSampleRate;
+
+        return result;
+    }
+
+    /** Returns an error message, or an empty string if all went well. */
+    juce::String renderInto (const juce::File& input, const juce::File& output)
+    {
+        if (output == input)
+            return "the output would overwrite the input";
+
+        auto* format = formatManager.findFormatForFileExtension (input.getFileExtension());
+
+        if (format == nullptr)
+            return "unsupported file type";
+
+        auto reader = createReader (*format, input);
+
+        if (reader == nullptr)
+            return "couldn't read the file";
+
+        auto numChannels = (int) reader->numChannels;
+        auto sampleRate = reader->sampleRate;
+        auto blockSize = renderer.options.blockSize;
+
+        output.getParentDirectory().createDirectory();
+        output.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream (output.createOutputStream());
+
+        if (stream == nullptr)
+            return "couldn't create " + output.getFullPathName();
+
+        std::unique_ptr<juce::AudioFormatWriter> writer (format->createWriterFor (stream.get(), sampleRate, (unsigned int) numChannels,
+                                                                                 (int) reader->bitsPerSample, reader->metadataValues, 0));
+
+        if (writer == nullptr)
+            return "couldn't write " + format->getFormatName() + " with this channel count, rate or bit depth";
+
+        stream.release(); // now owned by the writer
+
+        processor.setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+        processor.prepareToPlay (sampleRate, blockSize);
+
+        buffer.setSize (numChannels, blockSize, false, false, true);
+
+        // Run on past the end of the input by the latency, which the reader fills
+        // with silence, and drop the same amount from the start of the output.
+        auto length = reader->lengthInSamples;
+        auto latency = (juce::int64) processor.getLatencySamples();
+
+        for (juce::int64 position = 0; position < length + latency; position += blockSize)
+        {
+            auto numSamples = (int) juce::jmin ((juce::int64) blockSize, length + latency - position);
+            buffer.setSize (numChannels, numSamples, false, false, true);
+
+            reader->read (&buffer, 0, numSamples, position, true, true);
+            processor.processBlock (buffer, midi);
+
+            auto numToSkip = (int) juce::jlimit ((juce::int64) 0, (juce::int64) numSamples, latency - position);
+
+            if (numToSkip < numSamples && ! writer->writeFromAudioSampleBuffer (buffer, numToSkip, numSamples - numToSkip))
+                return "couldn't write " + output.getFullPathName();
+        }
+
+        processor.releaseResources();
+
+        lastLengthInSamples = length;
+        lastSampleRate = sampleRate;
+        return {};
+    }
+
+    BatchRenderer& renderer;
+    juce::AudioFormatManager formatManager;
+    SimpleEQAudioProcessor processor;
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    juce::int64 lastLengthInSamples = 0;
+    double lastSampleRate = 44100.0;
+};
+
+//==============================================================================
+BatchRenderer::BatchRenderer (Options o)
+    : options (std::move (o))
+{
+    options.numWorkers = juce::jmax (1, options.numWorkers);
+    options.blockSize = juce::jmax (1, options.blockSize);
+}
+
+BatchRenderer::~BatchRenderer() = default;
+
+BatchRenderer::Summary BatchRenderer::render (const juce::Array<Input>& inputsToRender, FileCallback onFileFinished)
+{
+    inputs = inputsToRender;
+    outputs = getOutputFiles (inputs, options.outputDirectory);
+    nextFile = 0;
+    callback = std::move (onFileFinished);
+    summary = {};
+    summary.numFiles = inputs.size();
+
+    if (! options.outputDirectory.createDirectory())
+    {
+        summary.numFailed = inputs.size();
+        return summary;
+    }
+
+    // No point starting more workers, and building their processors, than
+    // there are files.
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    for (int i = 0; i < juce::jmin (options.numWorkers, inputs.size()); ++i)
+        workers.push_back (std::make_unique<Worker> (*this));
+
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (auto& worker : workers)
+        worker->startThread();
+
+    for (auto& worker : workers)
+        worker->waitForThreadToExit (-1);
+
+    summary.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    return summary;
+}
+
+std::unique_ptr<juce::AudioFormatReader> BatchRenderer::createReader (juce::AudioFormat& format, const juce::File& file)
+{
+    if (std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped { format.createMemoryMappedReader (file) })
+        if (mapped->mapEntireFile())
+            return mapped;
+
+    if (auto stream = file.createInputStream())
+        return std::unique_ptr<juce::AudioFormatReader> (format.createReaderFor (stream.release(), true));
+
+    return {};
+}
+
+juce::Array<juce::File> BatchRenderer::getOutputFiles (const juce::Array<Input>& inputs, const juce::File& outputDirectory,
+                                                       const juce::String& extension)
+{
+    juce::Array<juce::File> outputs;
+
+    for (auto& input : inputs)
+    {
+        auto output = outputDirectory.getChildFile (input.relativePath);
+
+        if (extension.isNotEmpty())
+            output = output.withFileExtension (extension);
+
+        outputs.add (outputs.contains (output) ? juce::File() : output);
+    }
+
+    return outputs;
+}
+
+void BatchRenderer::finishFile (const FileResult& result)
+{
+    const juce::ScopedLock sl (resultLock);
+
+    if (result.error.isEmpty())
+        summary.audioSeconds += result.audioSeconds;
+    else
+        ++summary.numFailed;
+
+    if (callback)
+        callback (result);
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 17 Oct 2026 9:41:16pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+//==============================================================================
+/**
+    Runs SimpleEQ over audio files offline, with no host, device or editor.
+
+    Files are shared out over a pool of worker threads. Each worker owns its own
+    SimpleEQAudioProcessor, loaded with the same saved state, and takes the next
+    file whenever it finishes one, so long and short files balance out. Files
+    are streamed through in large blocks. WAV and AIFF are read straight out of
+    a memory map, and every other format goes through its regular reader.
+
+    The output has the same name, format, channel count, sample rate and bit
+    depth as the input, and the same length: the processor's latency is
+    compensated for, and the tail is cut off at the end of the file. Each input
+    carries the path its output takes under the output directory, so files
+    found in different subdirectories stay apart.
+*/
+class BatchRenderer
+{
+public:
+    struct Options
+    {
+        juce::MemoryBlock state;            // from SimpleEQAudioProcessor::getStateInformation()
+        juce::File outputDirectory;
+        int numWorkers = juce::SystemStats::getNumCpus();
+        int blockSize = 16384;
+    };
+
+    /** A file to render, and its path relative to the output directory. */
+    struct Input
+    {
+        juce::File file;
+        juce::String relativePath;
+    };
+
+    struct FileResult
+    {
+        juce::File input, output;
+        juce::String error;                 // empty if the file rendered
+        double audioSeconds = 0.0, wallSeconds = 0.0;
+    };
+
+    struct Summary
+    {
+        int numFiles = 0, numFailed = 0;
+        double audioSeconds = 0.0, wallSeconds = 0.0;
+
+        /** How many times faster than realtime the whole batch ran. */
+        double getRealtimeMultiple() const noexcept    { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+    };
+
+    /** Called on a worker thread as each file finishes, but never by two workers at once. */
+    using FileCallback = std::function<void (const FileResult&)>;
+
+    explicit BatchRenderer (Options);
+    ~BatchRenderer();
+
+    /** Renders every file and returns once they are all done. The processors are
+        created on the calling thread, which should therefore be the message
+        thread.
+    */
+    Summary render (const juce::Array<Input>& inputs, FileCallback onFileFinished = {});
+
+    /** Memory maps the whole file when the format supports it, which saves a copy
+        through a stream, and otherwise opens the format's regular reader.
+    */
+    static std::unique_ptr<juce::AudioFormatReader> createReader (juce::AudioFormat&, const juce::File&);
+
+    /** Where each input's output goes, with the given extension, or its own if
+        that is empty. An input whose output would be the same file as an
+        earlier one's gets juce::File() instead, so that no two renders ever
+        write the same file.
+    */
+    static juce::Array<juce::File> getOutputFiles (const juce::Array<Input>&, const juce::File& outputDirectory,
+                                                   const juce::String& extension = {});
+
+private:
+    class Worker;
+
+    void finishFile (const FileResult&);
+
+    Options options;
+    juce::Array<Input> inputs;
+    juce::Array<juce::File> outputs;
+    std::atomic<int> nextFile { 0 };
+
+    juce::CriticalSection resultLock;
+    FileCallback callback;
+    Summary summary;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchRenderer)
+};
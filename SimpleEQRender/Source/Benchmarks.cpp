@@ -0,0 +1,392 @@
+/*
+  ==============================================================================
+
+    Benchmarks.cpp
+    Created: 19 Oct 2026 10:14:52am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/EQChain.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double defaultSampleRate = 48000.0;
+    constexpr int defaultBlockSize = 512;
+    constexpr int numChannels = 2;
+
+    /** How much audio each case processes, after as much again to warm up. */
+    constexpr double audioSeconds = 10.0;
+
+    /** Cuts at both ends, the peak, and five parametric bands. */
+    ChainSettings makeSession (BandEngine engine = BandEngine::Biquad)
+    {
+        ChainSettings settings;
+        auto& bands = settings.bands;
+
+        bands[ChainSettings::LowCut]  = { BandType::LowCut,    30.f,    0.f,   1.f,  Slope::Slope_24, engine };
+        bands[ChainSettings::Peak]    = { BandType::Bell,      1000.f,  3.f,   1.f,  Slope::Slope_12, engine };
+        bands[ChainSettings::HighCut] = { BandType::HighCut,   18000.f, 0.f,   1.f,  Slope::Slope_12, engine };
+        bands[3]                      = { BandType::LowShelf,  100.f,   2.f,   0.7f, Slope::Slope_12, engine };
+        bands[4]                      = { BandType::Bell,      250.f,   -3.f,  2.f,  Slope::Slope_12, engine };
+        bands[5]                      = { BandType::Bell,      3000.f,  2.f,   1.5f, Slope::Slope_12, engine };
+        bands[6]                      = { BandType::HighShelf, 10000.f, 1.5f,  0.7f, Slope::Slope_12, engine };
+        bands[7]                      = { BandType::Notch,     60.f,    0.f,   8.f,  Slope::Slope_12, engine };
+
+        return settings;
+    }
+
+    /** session with every band moved a little for the given block, so that the
+        control grid never settles.
+    */
+    ChainSettings getAutomatedSession (const ChainSettings& session, int block)
+    {
+        auto settings = session;
+        auto position = (float) std::sin (block * 0.05);
+
+        for (auto& band : settings.bands)
+        {
+            band.frequency *= std::exp2 (position * 0.5f);
+            band.gainInDecibels += position;
+        }
+
+        return settings;
+    }
+
+    /** Runs audioSeconds of noise through the chain in blocks of blockSize and
+        returns how many times faster than realtime that was. beforeBlock, if
+        given, is called with each block's index before it is processed.
+    */
+    template <typename SampleType>
+    double getRealtimeMultiple (EQChain<SampleType>& chain, double sampleRate, int blockSize,
+                                const std::function<void (int)>& beforeBlock = {})
+    {
+        // Every block starts from the same noise, so that the bands' gains can't
+        // build up from one block to the next. The copy costs the same everywhere.
+        juce::AudioBuffer<SampleType> noise (numChannels, blockSize), buffer (numChannels, blockSize);
+        juce::Random random (1);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                noise.setSample (ch, i, (SampleType) (random.nextFloat() * 0.5f - 0.25f));
+
+        auto numBlocks = (int) (audioSeconds * sampleRate / blockSize);
+        double elapsedMs = 0.0;
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                if (beforeBlock)
+                    beforeBlock (i);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    buffer.copyFrom (ch, 0, noise, ch, 0, blockSize);
+
+                juce::dsp::AudioBlock<SampleType> block (buffer);
+                chain.process (block);
+            }
+
+            elapsedMs = juce::Time::getMillisecondCounterHiRes() - startTime;
+        }
+
+        return audioSeconds / juce::jmax (1.0e-9, elapsedMs * 0.001);
+    }
+
+    /** Somewhere for results to go that the optimiser can't see through. */
+    volatile float resultSink = 0.f;
+
+    void printRow (std::initializer_list<juce::String> columns)
+    {
+        for (auto& column : columns)
+            std::cout << column.paddedRight (' ', 14);
+
+        std::cout << "\n";
+    }
+
+    juce::String formatMultiple (double multiple)
+    {
+        return juce::String (multiple, 1) + "x";
+    }
+
+    //==============================================================================
+    /** Every oversampling factor with both of its filters. */
+    void benchmarkOversampling()
+    {
+        std::cout << "Oversampling, float, " << juce::String (juce::roundToInt (defaultSampleRate / 1000.0)) << " kHz, "
+                  << defaultBlockSize << "-sample blocks\n\n";
+
+        printRow ({ "factor", "filter", "latency", "realtime" });
+
+        EQChain<float> chain;
+        chain.prepare (defaultSampleRate, (size_t) defaultBlockSize, (size_t) numChannels);
+        chain.setTargetBands (makeSession());
+
+        for (int order = 0; order <= EQChain<float>::maxOversamplingOrder; ++order)
+        {
+            for (auto filter : { OversamplingFilter::IIRHalfBand, OversamplingFilter::FIRLinearPhase })
+            {
+                if (order == 0 && filter != OversamplingFilter::IIRHalfBand)
+                    continue;
+
+                chain.setOversampling (order, filter);
+                auto multiple = getRealtimeMultiple (chain, defaultSampleRate, defaultBlockSize);
+
+                printRow ({ juce::String (1 << order) + "x",
+                            order == 0 ? "-" : filter == OversamplingFilter::IIRHalfBand ? "IIR half-band" : "FIR linear",
+                            juce::String (chain.getLatencyInSamples()),
+                            formatMultiple (multiple) });
+            }
+        }
+    }
+
+    //==============================================================================
+    /** The double precision chain against the float one. A double register holds
+        half as many channels, so the ratio is mostly the SIMD width.
+    */
+    void benchmarkPrecision()
+    {
+        std::cout << "Precision, " << defaultBlockSize << "-sample blocks, no oversampling\n\n";
+
+        printRow ({ "sample rate", "float", "double", "double/float" });
+
+        for (auto sampleRate : { 48000.0, 96000.0, 192000.0 })
+        {
+            EQChain<float> floatChain;
+            floatChain.prepare (sampleRate, (size_t) defaultBlockSize, (size_t) numChannels);
+            floatChain.setTargetBands (makeSession());
+
+            EQChain<double> doubleChain;
+            doubleChain.prepare (sampleRate, (size_t) defaultBlockSize, (size_t) numChannels);
+            doubleChain.setTargetBands (makeSession());
+
+            auto floatMultiple = getRealtimeMultiple (floatChain, sampleRate, defaultBlockSize);
+            auto doubleMultiple = getRealtimeMultiple (doubleChain, sampleRate, defaultBlockSize);
+
+            printRow ({ juce::String (juce::roundToInt (sampleRate / 1000.0)) + " kHz",
+                        formatMultiple (floatMultiple),
+                        formatMultiple (doubleMultiple),
+                        juce::String (floatMultiple / doubleMultiple, 2) });
+        }
+    }
+
+    //==============================================================================
+    /** The control grid under automation against designing every band once per
+        host block, which is what the chain did before the grid. That per-block
+        figure is the static processing plus the time the designs take on their
+        own, so it flatters per-block updates a little: they also had to ramp.
+    */
+    void benchmarkControlGrid()
+    {
+        std::cout << "Control grid, float, " << juce::String (juce::roundToInt (defaultSampleRate / 1000.0)) << " kHz, every "
+                  << (int) EQChain<float>::controlInterval << " samples\n\n";
+
+        printRow ({ "block size", "static", "per block", "grid", "overhead" });
+
+        const auto session = makeSession();
+
+        for (auto blockSize : { 64, 512, 2048 })
+        {
+            EQChain<float> chain;
+            chain.prepare (defaultSampleRate, (size_t) blockSize, (size_t) numChannels);
+            chain.setTargetBands (session);
+
+            auto staticMultiple = getRealtimeMultiple (chain, defaultSampleRate, blockSize);
+
+            auto automatedMultiple = getRealtimeMultiple (chain, defaultSampleRate, blockSize, [&] (int block)
+            {
+                chain.setTargetBands (getAutomatedSession (session, block));
+            });
+
+            auto numBlocks = (int) (audioSeconds * defaultSampleRate / blockSize);
+            BandDesign::SectionCoefficients<float> sections;
+            auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                for (auto& band : session.bands)
+                    BandDesign::makeSections (band, defaultSampleRate, sections);
+
+                resultSink = sections[0][0];
+            }
+
+            auto designSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+            auto perBlockMultiple = audioSeconds / (audioSeconds / staticMultiple + designSeconds);
+
+            printRow ({ juce::String (blockSize),
+                        formatMultiple (staticMultiple),
+                        formatMultiple (perBlockMultiple),
+                        formatMultiple (automatedMultiple),
+                        juce::String ((perBlockMultiple / automatedMultiple - 1.0) * 100.0, 1) + "%" });
+        }
+    }
+
+    //==============================================================================
+    /** Every band on the biquads and then on the SVFs, left alone and under
+        automation. Under automation the biquads step to new coefficients at each
+        grid point, while the SVFs ramp theirs sample by sample.
+    */
+    void benchmarkEngines()
+    {
+        std::cout << "Band engines, float, " << juce::String (juce::roundToInt (defaultSampleRate / 1000.0)) << " kHz, "
+                  << defaultBlockSize << "-sample blocks\n\n";
+
+        printRow ({ "engine", "static", "modulated" });
+
+        for (auto engine : { BandEngine::Biquad, BandEngine::SVF })
+        {
+            const auto session = makeSession (engine);
+
+            EQChain<float> chain;
+            chain.prepare (defaultSampleRate, (size_t) defaultBlockSize, (size_t) numChannels);
+            chain.setTargetBands (session);
+
+            auto staticMultiple = getRealtimeMultiple (chain, defaultSampleRate, defaultBlockSize);
+            auto modulatedMultiple = getRealtimeMultiple (chain, defaultSampleRate, defaultBlockSize, [&] (int block)
+            {
+                chain.setTargetBands (getAutomatedSession (session, block));
+            });
+
+            printRow ({ engine == BandEngine::SVF ? "SVF" : "IIR biquad",
+                        formatMultiple (staticMultiple),
+                        formatMultiple (modulatedMultiple) });
+        }
+    }
+
+    //==============================================================================
+    /** Saving and loading a session's worth of plugin states, in the binary
+        format and as the APVTS XML that setStateInformation falls back to.
+    */
+    void benchmarkState()
+    {
+        constexpr int numInstances = 1000;
+
+        std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+        juce::Random random (1);
+
+        // Every instance gets its own settings, so that no two states are alike.
+        for (int i = 0; i < numInstances; ++i)
+        {
+            processors.push_back (std::make_unique<SimpleEQAudioProcessor>());
+
+            for (auto* parameter : processors.back()->getParameters())
+                parameter->setValueNotifyingHost (random.nextFloat());
+        }
+
+        std::vector<juce::MemoryBlock> binaryStates ((size_t) numInstances), xmlStates ((size_t) numInstances);
+
+        // Each is run twice and the second run timed, as for the chains.
+        auto getMilliseconds = [] (const std::function<void()>& function)
+        {
+            function();
+
+            auto startTime = juce::Time::getMillisecondCounterHiRes();
+            function();
+            return juce::Time::getMillisecondCounterHiRes() - startTime;
+        };
+
+        auto binarySaveMs = getMilliseconds ([&]
+        {
+            for (size_t i = 0; i < processors.size(); ++i)
+            {
+                binaryStates[i].reset();
+                processors[i]->getStateInformation (binaryStates[i]);
+            }
+        });
+
+        auto binaryLoadMs = getMilliseconds ([&]
+        {
+            for (size_t i = 0; i < processors.size(); ++i)
+                processors[i]->setStateInformation (binaryStates[i].getData(), (int) binaryStates[i].getSize());
+        });
+
+        auto xmlSaveMs = getMilliseconds ([&]
+        {
+            for (size_t i = 0; i < processors.size(); ++i)
+            {
+                xmlStates[i].reset();
+
+                if (auto xml = processors[i]->apvst.copyState().createXml())
+                    juce::AudioProcessor::copyXmlToBinary (*xml, xmlStates[i]);
+            }
+        });
+
+        auto xmlLoadMs = getMilliseconds ([&]
+        {
+            for (size_t i = 0; i < processors.size(); ++i)
+                processors[i]->setStateInformation (xmlStates[i].getData(), (int) xmlStates[i].getSize());
+        });
+
+        auto getAverageSize = [] (const std::vector<juce::MemoryBlock>& states)
+        {
+            size_t total = 0;
+
+            for (auto& state : states)
+                total += state.getSize();
+
+            return juce::String ((juce::int64) (total / states.size())) + " bytes";
+        };
+
+        std::cout << "State, " << numInstances << " instances\n\n";
+
+        printRow ({ "format", "save", "load", "size" });
+        printRow ({ "binary", juce::String (binarySaveMs, 1) + " ms", juce::String (binaryLoadMs, 1) + " ms", getAverageSize (binaryStates) });
+        printRow ({ "XML", juce::String (xmlSaveMs, 1) + " ms", juce::String (xmlLoadMs, 1) + " ms", getAverageSize (xmlStates) });
+    }
+
+    //==============================================================================
+    struct Benchmark
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    const std::vector<Benchmark>& getBenchmarks()
+    {
+        static const std::vector<Benchmark> benchmarks
+        {
+            { "oversampling", benchmarkOversampling },
+            { "precision",    benchmarkPrecision },
+            { "control-grid", benchmarkControlGrid },
+            { "engines",      benchmarkEngines },
+            { "state",        benchmarkState }
+        };
+
+        return benchmarks;
+    }
+}
+
+//==============================================================================
+juce::StringArray Benchmarks::getNames()
+{
+    juce::StringArray names;
+
+    for (auto& benchmark : getBenchmarks())
+        names.add (benchmark.name);
+
+    return names;
+}
+
+bool Benchmarks::run (const juce::String& name)
+{
+    auto ranAny = false;
+
+    for (auto& benchmark : getBenchmarks())
+    {
+        if (name != "all" && name != benchmark.name)
+            continue;
+
+        if (ranAny)
+            std::cout << "\n";
+
+        benchmark.run();
+        ranAny = true;
+    }
+
+    return ranAny;
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 19 Oct 2026 10:14:52am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Timings of SimpleEQ's processing options, run with --bench <name>.
+
+    Every benchmark runs the same session, stereo noise through cuts at both
+    ends, the peak and a handful of parametric bands, so that the figures can
+    be compared with each other. Speeds are given as multiples of realtime.
+*/
+namespace Benchmarks
+{
+    /** The names --bench takes, besides "all". */
+    juce::StringArray getNames();
+
+    /** Runs the named benchmark, or every one of them for "all", and prints the
+        results. Returns false if there's no benchmark by that name.
+    */
+    bool run (const juce::String& name);
+}
@@ -0,0 +1,494 @@
+/*
+  ==============================================================================
+
+    FilterGraph.cpp
+    Created: 17 Oct 2026 10:52:07pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "FilterGraph.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    // The channel index AudioProcessorGraph uses for a connection's MIDI.
+    constexpr int midiChannelIndex = 0x1000;
+
+    /** Reads the bus layouts in a FILTER's LAYOUT element, as the host writes them. */
+    void restoreBusLayout (juce::AudioProcessor& processor, const juce::XmlElement& layoutXml)
+    {
+        auto layout = processor.getBusesLayout();
+
+        for (auto isInput : { true, false })
+        {
+            auto& buses = isInput ? layout.inputBuses : layout.outputBuses;
+
+            if (auto* busesXml = layoutXml.getChildByName (isInput ? "INPUTS" : "OUTPUTS"))
+            {
+                for (auto* busXml : busesXml->getChildWithTagNameIterator ("BUS"))
+                {
+                    auto index = busXml->getIntAttribute ("index");
+                    auto name = busXml->getStringAttribute ("layout");
+
+                    if (juce::isPositiveAndBelow (index, buses.size()))
+                        buses.getReference (index) = name == "disabled" ? juce::AudioChannelSet::disabled()
+                                                                        : juce::AudioChannelSet::fromAbbreviatedString (name);
+                }
+            }
+        }
+
+        // A layout the plugin turns down leaves it with its own, which is what the host does too.
+        processor.setBusesLayout (layout);
+    }
+}
+
+//==============================================================================
+struct FilterGraph::Node
+{
+    enum class Kind { audioInput, audioOutput, midiInput, midiOutput, plugin, passThrough };
+
+    /** Delays one connection so that it lines up with the other inputs of its node. */
+    struct DelayLine
+    {
+        void prepare (int numSamples)
+        {
+            line.assign ((size_t) numSamples, 0.0f);
+            position = 0;
+        }
+
+        /** Adds the delayed source to destination. */
+        void process (const float* source, float* destination, int numSamples) noexcept
+        {
+            if (line.empty())
+            {
+                juce::FloatVectorOperations::add (destination, source, numSamples);
+                return;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                destination[i] += line[position];
+                line[position] = source[i];
+
+                if (++position == line.size())
+                    position = 0;
+            }
+        }
+
+        std::vector<float> line;
+        size_t position = 0;
+    };
+
+    struct AudioInput
+    {
+        size_t source;
+        int sourceChannel, channel;
+        DelayLine delay;
+    };
+
+    juce::uint32 uid = 0;
+    Kind kind = Kind::passThrough;
+    std::unique_ptr<juce::AudioProcessor> processor;
+    int numInputs = 0, numOutputs = 0;
+
+    std::vector<AudioInput> audioInputs;
+    std::vector<size_t> midiSources;
+    std::vector<size_t> sources, dependents;    // each node once, whatever it sends
+
+    int numPendingSources = 0;
+    int inputLatency = 0, outputLatency = 0;
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+};
+
+//==============================================================================
+class FilterGraph::Worker  : public juce::Thread
+{
+public:
+    explicit Worker (FilterGraph& g)
+        : juce::Thread ("Filter graph worker"), graph (g)
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        graph.runNodes (true);
+    }
+
+private:
+    FilterGraph& graph;
+};
+
+//==============================================================================
+FilterGraph::FilterGraph() = default;
+
+FilterGraph::~FilterGraph()
+{
+    releaseResources();
+}
+
+juce::String FilterGraph::load (const juce::File& file, juce::StringArray& warnings)
+{
+    releaseResources();
+    nodes.clear();
+
+    auto xml = juce::parseXML (file);
+
+    if (xml == nullptr || ! xml->hasTagName ("FILTERGRAPH"))
+        return file.getFullPathName() + " isn't a filter graph";
+
+    juce::AudioPluginFormatManager formatManager;
+    formatManager.addDefaultFormats();
+
+    for (auto* filterXml : xml->getChildWithTagNameIterator ("FILTER"))
+    {
+        juce::PluginDescription description;
+
+        if (auto* pluginXml = filterXml->getChildByName ("PLUGIN"))
+            description.loadFromXml (*pluginXml);
+
+        auto node = std::make_unique<Node>();
+        node->uid = (juce::uint32) filterXml->getIntAttribute ("uid");
+
+        if (description.pluginFormatName == "Internal")
+        {
+            if (description.name == "Audio Input")          node->kind = Node::Kind::audioInput;
+            else if (description.name == "Audio Output")    node->kind = Node::Kind::audioOutput;
+            else if (description.name == "MIDI Input")      node->kind = Node::Kind::midiInput;
+            else if (description.name == "MIDI Output")     node->kind = Node::Kind::midiOutput;
+            else
+            {
+                node->numInputs = description.numInputChannels;
+                node->numOutputs = description.numOutputChannels;
+                warnings.add ("The host's " + description.name + " isn't available, so it passes audio straight through");
+            }
+        }
+        else
+        {
+            juce::String error;
+
+            if (description.name == JucePlugin_Name)
+                node->processor = std::make_unique<SimpleEQAudioProcessor>();
+            else
+                node->processor = formatManager.createPluginInstance (description, 44100.0, 512, error);
+
+            if (node->processor != nullptr)
+            {
+                node->kind = Node::Kind::plugin;
+
+                if (auto* layoutXml = filterXml->getChildByName ("LAYOUT"))
+                    restoreBusLayout (*node->processor, *layoutXml);
+
+                juce::MemoryBlock state;
+                state.fromBase64Encoding (filterXml->getChildElementAllSubText ("STATE", {}));
+
+                if (state.getSize() > 0)
+                    node->processor->setStateInformation (state.getData(), (int) state.getSize());
+
+                node->numInputs = node->processor->getTotalNumInputChannels();
+                node->numOutputs = node->processor->getTotalNumOutputChannels();
+            }
+            else if (description.numInputChannels == 0)
+            {
+                node->kind = Node::Kind::audioInput;
+                warnings.add ("Couldn't load " + description.name + ", so it plays the input file instead");
+            }
+            else
+            {
+                node->numInputs = description.numInputChannels;
+                node->numOutputs = description.numOutputChannels;
+                warnings.add ("Couldn't load " + description.name + ", so it passes audio straight through");
+            }
+        }
+
+        nodes.push_back (std::move (node));
+    }
+
+    auto findNode = [this] (int uid)
+    {
+        for (size_t i = 0; i < nodes.size(); ++i)
+            if (nodes[i]->uid == (juce::uint32) uid)
+                return (int) i;
+
+        return -1;
+    };
+
+    for (auto* connectionXml : xml->getChildWithTagNameIterator ("CONNECTION"))
+    {
+        auto sourceIndex = findNode (connectionXml->getIntAttribute ("srcFilter"));
+        auto destIndex = findNode (connectionXml->getIntAttribute ("dstFilter"));
+        auto sourceChannel = connectionXml->getIntAttribute ("srcChannel");
+        auto destChannel = connectionXml->getIntAttribute ("dstChannel");
+
+        if (sourceIndex < 0 || destIndex < 0 || (sourceChannel == midiChannelIndex) != (destChannel == midiChannelIndex))
+        {
+            warnings.add ("Skipped a connection that doesn't lead anywhere");
+            continue;
+        }
+
+        auto& source = *nodes[(size_t) sourceIndex];
+        auto& dest = *nodes[(size_t) destIndex];
+
+        if (sourceChannel == midiChannelIndex)
+        {
+            dest.midiSources.push_back ((size_t) sourceIndex);
+        }
+        else
+        {
+            // The graph's own inputs and outputs have as many channels as are connected.
+            if (source.kind == Node::Kind::audioInput)
+                source.numOutputs = juce::jmax (source.numOutputs, sourceChannel + 1);
+
+            if (dest.kind == Node::Kind::audioOutput)
+                dest.numInputs = juce::jmax (dest.numInputs, destChannel + 1);
+
+            if (! juce::isPositiveAndBelow (sourceChannel, source.numOutputs)
+                 || ! juce::isPositiveAndBelow (destChannel, dest.numInputs))
+            {
+                warnings.add ("Skipped a connection to a channel that doesn't exist");
+                continue;
+            }
+
+            dest.audioInputs.push_back ({ (size_t) sourceIndex, sourceChannel, destChannel, {} });
+        }
+
+        if (std::find (dest.sources.begin(), dest.sources.end(), (size_t) sourceIndex) == dest.sources.end())
+        {
+            dest.sources.push_back ((size_t) sourceIndex);
+            source.dependents.push_back ((size_t) destIndex);
+        }
+    }
+
+    numOutputChannels = 0;
+
+    for (auto& node : nodes)
+        if (node->kind == Node::Kind::audioOutput)
+            numOutputChannels = juce::jmax (numOutputChannels, node->numInputs);
+
+    return sortNodes();
+}
+
+/** Puts the nodes in dependency order, which also finds any feedback loop. */
+juce::String FilterGraph::sortNodes()
+{
+    order.clear();
+    roots.clear();
+
+    std::vector<size_t> numSourcesLeft;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        numSourcesLeft.push_back (nodes[i]->sources.size());
+
+        if (nodes[i]->sources.empty())
+        {
+            roots.push_back (i);
+            order.push_back (i);
+        }
+    }
+
+    for (size_t i = 0; i < order.size(); ++i)
+        for (auto dependent : nodes[order[i]]->dependents)
+            if (--numSourcesLeft[dependent] == 0)
+                order.push_back (dependent);
+
+    if (order.size() < nodes.size())
+        return "The graph has a feedback loop, which can't be rendered offline";
+
+    return {};
+}
+
+void FilterGraph::prepare (int numInputChannelsToUse, double sampleRate, int maxBlockSize, int numThreads)
+{
+    releaseResources();
+    numInputChannels = numInputChannelsToUse;
+
+    for (auto& node : nodes)
+    {
+        node->buffer.setSize (juce::jmax (node->numInputs, node->numOutputs), maxBlockSize);
+        node->midi.ensureSize (4096);
+
+        if (node->processor != nullptr)
+        {
+            node->processor->setNonRealtime (true);
+            node->processor->setRateAndBufferSizeDetails (sampleRate, maxBlockSize);
+            node->processor->prepareToPlay (sampleRate, maxBlockSize);
+        }
+    }
+
+    // Latencies are only known once everything has been prepared.
+    computeLatencies();
+
+    readyNodes.reserve (nodes.size());
+    shouldExit = false;
+    isPrepared = true;
+
+    for (int i = 1; i < juce::jmin (numThreads, (int) nodes.size()); ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this));
+        workers.back()->startThread();
+    }
+}
+
+void FilterGraph::releaseResources()
+{
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        shouldExit = true;
+    }
+
+    readyToRun.notify_all();
+    workers.clear();
+
+    if (isPrepared)
+        for (auto& node : nodes)
+            if (node->processor != nullptr)
+                node->processor->releaseResources();
+
+    isPrepared = false;
+}
+
+/** Delays every connection by however much less latency its source has than the
+    slowest source feeding the same node.
+*/
+void FilterGraph::computeLatencies()
+{
+    latencySamples = 0;
+
+    for (auto index : order)
+    {
+        auto& node = *nodes[index];
+        node.inputLatency = 0;
+
+        for (auto& input : node.audioInputs)
+            node.inputLatency = juce::jmax (node.inputLatency, nodes[input.source]->outputLatency);
+
+        for (auto& input : node.audioInputs)
+            input.delay.prepare (node.inputLatency - nodes[input.source]->outputLatency);
+
+        node.outputLatency = node.inputLatency + (node.processor != nullptr ? node.processor->getLatencySamples() : 0);
+
+        if (node.kind == Node::Kind::audioOutput)
+            latencySamples = juce::jmax (latencySamples, node.inputLatency);
+    }
+}
+
+//==============================================================================
+void FilterGraph::process (juce::AudioBuffer<float>& audio, juce::MidiBuffer& midi)
+{
+    jassert (isPrepared);
+    jassert (audio.getNumChannels() >= juce::jmax (numInputChannels, numOutputChannels));
+
+    auto numSamples = audio.getNumSamples();
+
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        blockAudio = &audio;
+        blockMidi = &midi;
+        blockSize = numSamples;
+
+        for (auto& node : nodes)
+            node->numPendingSources = (int) node->sources.size();
+
+        readyNodes.assign (roots.begin(), roots.end());
+        numNodesLeft = nodes.size();
+    }
+
+    readyToRun.notify_all();
+    runNodes (false);
+
+    audio.clear();
+    midi.clear();
+
+    for (auto& node : nodes)
+    {
+        if (node->kind == Node::Kind::audioOutput)
+            for (int channel = 0; channel < node->numInputs; ++channel)
+                audio.addFrom (channel, 0, node->buffer, channel, 0, numSamples);
+        else if (node->kind == Node::Kind::midiOutput)
+            midi.addEvents (node->midi, 0, numSamples, 0);
+    }
+}
+
+/** Takes ready nodes until there are none left. The thread calling process()
+    returns once the whole block is done, and the workers once the graph is
+    released.
+*/
+void FilterGraph::runNodes (bool isWorker)
+{
+    std::unique_lock<std::mutex> lock (mutex);
+
+    for (;;)
+    {
+        readyToRun.wait (lock, [&] { return ! readyNodes.empty() || (isWorker ? shouldExit : numNodesLeft == 0); });
+
+        if (readyNodes.empty())
+            return;
+
+        auto index = readyNodes.back();
+        readyNodes.pop_back();
+
+        lock.unlock();
+        processNode (index);
+        lock.lock();
+
+        auto numReadyBefore = readyNodes.size();
+
+        for (auto dependent : nodes[index]->dependents)
+            if (--nodes[dependent]->numPendingSources == 0)
+                readyNodes.push_back (dependent);
+
+        // This thread takes the next ready node itself, so others are only woken
+        // for any beyond that, or to let process() return.
+        if (--numNodesLeft == 0 || readyNodes.size() > numReadyBefore + 1)
+            readyToRun.notify_all();
+    }
+}
+
+void FilterGraph::processNode (size_t index)
+{
+    auto& node = *nodes[index];
+    juce::AudioBuffer<float> audio (node.buffer.getArrayOfWritePointers(), node.buffer.getNumChannels(), blockSize);
+
+    node.midi.clear();
+
+    if (node.kind == Node::Kind::audioInput)
+    {
+        for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+        {
+            if (channel < numInputChannels)
+                audio.copyFrom (channel, 0, *blockAudio, channel, 0, blockSize);
+            else
+                audio.clear (channel, 0, blockSize);
+        }
+
+        return;
+    }
+
+    if (node.kind == Node::Kind::midiInput)
+    {
+        node.midi.addEvents (*blockMidi, 0, blockSize, 0);
+        return;
+    }
+
+    audio.clear();
+
+    for (auto& input : node.audioInputs)
+        input.delay.process (nodes[input.source]->buffer.getReadPointer (input.sourceChannel),
+                             audio.getWritePointer (input.channel), blockSize);
+
+    for (auto source : node.midiSources)
+        node.midi.addEvents (nodes[source]->midi, 0, blockSize, 0);
+
+    if (node.processor != nullptr)
+        node.processor->processBlock (audio, node.midi);
+}
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    FilterGraph.h
+    Created: 17 Oct 2026 10:52:07pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    An offline stand-in for juce::AudioProcessorGraph, loaded from the
+    .filtergraph files saved by JUCE's AudioPluginHost.
+
+    Every block, each node is processed as soon as everything feeding it has
+    been, so branches that don't depend on each other run side by side on a
+    small pool of threads. Connections from a node with less latency than the
+    others feeding the same destination are delayed to line up with them, as
+    the host does, and getLatencySamples() reports what is left at the output.
+
+    SimpleEQ itself is linked in and created directly. Any other plugin is
+    looked up through the usual plugin formats. A plugin that can't be found
+    is replaced, with a warning, by a node that passes its audio straight
+    through, or by the graph's audio input if it was a generator with no
+    inputs of its own, so a graph that plays a file from a player plugin can
+    still be rendered from that file.
+*/
+class FilterGraph
+{
+public:
+    FilterGraph();
+    ~FilterGraph();
+
+    /** Loads a graph, creating its plugins. This must be called on the message
+        thread. Returns an error message, or an empty string if the graph loaded;
+        plugins that had to be replaced are added to warnings.
+    */
+    juce::String load (const juce::File&, juce::StringArray& warnings);
+
+    /** Prepares every plugin and starts numThreads - 1 worker threads; the thread
+        that calls process() makes up the rest.
+    */
+    void prepare (int numInputChannels, double sampleRate, int maxBlockSize, int numThreads);
+    void releaseResources();
+
+    /** The number of channels feeding the graph's audio output node. */
+    int getNumOutputChannels() const noexcept       { return numOutputChannels; }
+
+    int getLatencySamples() const noexcept          { return latencySamples; }
+
+    /** Runs one block through the graph. The buffer holds the input channels on
+        the way in and the output channels on the way out, so it needs as many
+        channels as the larger of the two. The MIDI buffer works the same way.
+    */
+    void process (juce::AudioBuffer<float>&, juce::MidiBuffer&);
+
+private:
+    struct Node;
+    class Worker;
+
+    juce::String sortNodes();
+    void computeLatencies();
+    void processNode (size_t index);
+    void runNodes (bool isWorker);
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<size_t> order;              // every node after all of its sources
+    std::vector<size_t> roots;              // nodes with no sources
+
+    int numInputChannels = 0, numOutputChannels = 0, latencySamples = 0;
+
+    // Scheduling state for the block in progress.
+    std::mutex mutex;
+    std::condition_variable readyToRun;
+    std::vector<size_t> readyNodes;
+    size_t numNodesLeft = 0;
+    bool shouldExit = false, isPrepared = false;
+    juce::AudioBuffer<float>* blockAudio = nullptr;
+    juce::MidiBuffer* blockMidi = nullptr;
+    int blockSize = 0;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterGraph)
+};
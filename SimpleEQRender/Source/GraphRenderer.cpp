@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    GraphRenderer.cpp
+    Created: 17 Oct 2026 11:20:43pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "GraphRenderer.h"
+
+GraphRenderer::GraphRenderer (FilterGraph& g, Options o)
+    : graph (g), options (std::move (o))
+{
+    options.numThreads = juce::jmax (1, options.numThreads);
+    options.blockSize = juce::jmax (1, options.blockSize);
+
+    formatManager.registerBasicFormats();
+}
+
+GraphRenderer::Summary GraphRenderer::render (const juce::Array<BatchRenderer::Input>& inputs, FileCallback onFileFinished)
+{
+    Summary summary;
+    summary.numFiles = inputs.size();
+
+    if (! options.outputDirectory.createDirectory())
+    {
+        summary.numFailed = inputs.size();
+        return summary;
+    }
+
+    // Every output is a WAV, so e.g. kick.aif and kick.wav would clash too.
+    auto outputs = BatchRenderer::getOutputFiles (inputs, options.outputDirectory, "wav");
+    auto batchStartTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (int i = 0; i < inputs.size(); ++i)
+    {
+        auto& input = inputs.getReference (i).file;
+
+        FileResult result;
+        result.input = input;
+        result.output = outputs[i];
+
+        auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        if (result.output == juce::File())
+            result.error = "another input renders to the same output file";
+        else
+            result.error = renderInto (input, result.output, result.audioSeconds);
+
+        result.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+        if (result.error.isEmpty())
+        {
+            summary.audioSeconds += result.audioSeconds;
+        }
+        else
+        {
+            ++summary.numFailed;
+
+            if (result.output != input && result.output != juce::File())
+                result.output.deleteFile();
+        }
+
+        if (onFileFinished)
+            onFileFinished (result);
+    }
+
+    summary.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - batchStartTime) * 0.001;
+    return summary;
+}
+
+juce::String GraphRenderer::renderInto (const juce::File& input, const juce::File& output, double& audioSeconds)
+{
+    if (output == input)
+        return "the output would overwrite the input";
+
+    if (graph.getNumOutputChannels() == 0)
+        return "the graph's audio output isn't connected to anything";
+
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    juce::MidiMessageSequence sequence;
+    double sampleRate = options.sampleRate;
+    juce::int64 length = 0;
+
+    if (input.hasFileExtension ("mid;midi"))
+    {
+        juce::FileInputStream stream (input);
+        juce::MidiFile midiFile;
+
+        if (! stream.openedOk() || ! midiFile.readFrom (stream))
+            return "couldn't read the MIDI file";
+
+        midiFile.convertTimestampTicksToSeconds();
+
+        for (int track = 0; track < midiFile.getNumTracks(); ++track)
+            sequence.addSequence (*midiFile.getTrack (track), 0.0);
+
+        length = (juce::int64) ((sequence.getEndTime() + options.tailSeconds) * sampleRate);
+    }
+    else
+    {
+        auto* format = formatManager.findFormatForFileExtension (input.getFileExtension());
+
+        if (format == nullptr)
+            return "unsupported file type";
+
+        reader = BatchRenderer::createReader (*format, input);
+
+        if (reader == nullptr)
+            return "couldn't read the file";
+
+        sampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+    }
+
+    auto numInputChannels = reader != nullptr ? (int) reader->numChannels : 0;
+    auto numOutputChannels = graph.getNumOutputChannels();
+    auto blockSize = options.blockSize;
+
+    output.getParentDirectory().createDirectory();
+    output.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream (output.createOutputStream());
+
+    if (stream == nullptr)
+        return "couldn't create " + output.getFullPathName();
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), sampleRate, (unsigned int) numOutputChannels, 24, {}, 0));
+
+    if (writer == nullptr)
+        return "couldn't write a WAV file with this channel count or rate";
+
+    stream.release(); // now owned by the writer
+
+    graph.prepare (numInputChannels, sampleRate, blockSize, options.numThreads);
+    buffer.setSize (juce::jmax (numInputChannels, numOutputChannels), blockSize);
+
+    // As in BatchRenderer, run on by the latency and drop as much from the start.
+    auto latency = (juce::int64) graph.getLatencySamples();
+    int nextEvent = 0;
+
+    for (juce::int64 position = 0; position < length + latency; position += blockSize)
+    {
+        auto numSamples = (int) juce::jmin ((juce::int64) blockSize, length + latency - position);
+        buffer.setSize (buffer.getNumChannels(), numSamples, false, false, true);
+        midi.clear();
+
+        if (reader != nullptr)
+        {
+            // Only as many channels as the file has, so that the reader doesn't fill the rest.
+            juce::AudioBuffer<float> inputChannels (buffer.getArrayOfWritePointers(), numInputChannels, numSamples);
+            reader->read (&inputChannels, 0, numSamples, position, true, true);
+        }
+
+        for (; nextEvent < sequence.getNumEvents(); ++nextEvent)
+        {
+            auto& message = sequence.getEventPointer (nextEvent)->message;
+            auto time = (juce::int64) std::llround (message.getTimeStamp() * sampleRate) - position;
+
+            if (time >= numSamples)
+                break;
+
+            midi.addEvent (message, (int) juce::jmax ((juce::int64) 0, time));
+        }
+
+        graph.process (buffer, midi);
+
+        auto numToSkip = (int) juce::jlimit ((juce::int64) 0, (juce::int64) numSamples, latency - position);
+        juce::AudioBuffer<float> outputChannels (buffer.getArrayOfWritePointers(), numOutputChannels, numSamples);
+
+        if (numToSkip < numSamples && ! writer->writeFromAudioSampleBuffer (outputChannels, numToSkip, numSamples - numToSkip))
+            return "couldn't write " + output.getFullPathName();
+    }
+
+    graph.releaseResources();
+
+    audioSeconds = (double) length / sampleRate;
+    return {};
+}
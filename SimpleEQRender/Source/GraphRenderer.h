@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    GraphRenderer.h
+    Created: 17 Oct 2026 11:20:43pm
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BatchRenderer.h"
+#include "FilterGraph.h"
+
+//==============================================================================
+/**
+    Renders audio or MIDI files through a FilterGraph, one file at a time, with
+    the graph itself spreading each block over several threads.
+
+    An audio file feeds the graph's audio input at its own sample rate. A MIDI
+    file feeds the MIDI input at the rate given in the options, and runs on for
+    a tail after its last event so that notes can ring out. Either way the
+    result is written as a 24-bit WAV with as many channels as the graph's
+    output, with the graph's latency taken off the start.
+*/
+class GraphRenderer
+{
+public:
+    struct Options
+    {
+        juce::File outputDirectory;
+        int numThreads = juce::SystemStats::getNumCpus();
+        int blockSize = 1024;
+        double sampleRate = 48000.0;        // for MIDI files
+        double tailSeconds = 2.0;           // for MIDI files
+    };
+
+    using FileResult = BatchRenderer::FileResult;
+    using Summary = BatchRenderer::Summary;
+    using FileCallback = BatchRenderer::FileCallback;
+
+    GraphRenderer (FilterGraph&, Options);
+
+    /** Renders every file and returns once they are all done. */
+    Summary render (const juce::Array<BatchRenderer::Input>& inputs, FileCallback onFileFinished = {});
+
+private:
+    /** Returns an error message, or an empty string if all went well. */
+    juce::String renderInto (const juce::File& input, const juce::File& output, double& audioSeconds);
+
+    FilterGraph& graph;
+    Options options;
+    juce::AudioFormatManager formatManager;
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GraphRenderer)
+};
@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BatchRenderer.h"
+#include "GraphRenderer.h"
+#include "MatchAnalyser.h"
+#include "Benchmarks.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: SimpleEQRender --preset <state> --output <directory> [--jobs <n>] [--block-size <n>] <files or directories...>\n"
+                     "       SimpleEQRender --graph <filtergraph> --output <directory> [--jobs <n>] [--block-size <n>]\n"
+                     "                      [--sample-rate <hz>] [--tail <seconds>] <files or directories...>\n"
+                     "       SimpleEQRender --match <reference> --output <state> [--jobs <n>] [--bands <n>] <file>\n"
+                     "       SimpleEQRender --bench <all|" << Benchmarks::getNames().joinIntoString ("|") << ">\n"
+                     "\n"
+                     "Renders WAV, AIFF and FLAC files through SimpleEQ. The preset is either the\n"
+                     "plugin's saved state or its parameters as XML. Directories are searched\n"
+                     "recursively, and their subdirectories are recreated under the output.\n"
+                     "\n"
+                     "With --graph, renders audio or MIDI files through a graph saved by the\n"
+                     "AudioPluginHost instead, using --jobs threads for each file. MIDI files are\n"
+                     "rendered at --sample-rate, with --tail seconds after the last event.\n"
+                     "\n"
+                     "With --match, fits up to --bands of SimpleEQ's parametric bands so that the\n"
+                     "file sounds tonally like the reference, and saves the plugin's state with\n"
+                     "them to --output, ready to be used as a --preset.\n"
+                     "\n"
+                     "With --bench, times SimpleEQ's processing options and prints the results.\n";
+    }
+
+    bool loadPreset (const juce::File& file, juce::MemoryBlock& state)
+    {
+        if (file.hasFileExtension ("xml"))
+        {
+            if (auto xml = juce::parseXML (file))
+            {
+                juce::AudioProcessor::copyXmlToBinary (*xml, state);
+                return true;
+            }
+
+            return false;
+        }
+
+        return file.loadFileAsData (state);
+    }
+
+    /** Files found in a directory keep their path below it, so that the same
+        name in two subdirectories doesn't end up as one output.
+    */
+    juce::Array<BatchRenderer::Input> findInputFiles (const juce::ArgumentList& args, const juce::String& wildcards)
+    {
+        juce::Array<BatchRenderer::Input> files;
+
+        for (auto& arg : args.arguments)
+        {
+            if (arg.isOption())
+                continue;
+
+            auto file = arg.resolveAsFile();
+
+            if (file.isDirectory())
+            {
+                for (auto& child : file.findChildFiles (juce::File::findFiles, true, wildcards))
+                    files.add ({ child, child.getRelativePathFrom (file) });
+            }
+            else
+            {
+                files.add ({ file, file.getFileName() });
+            }
+        }
+
+        return files;
+    }
+
+    void printResult (const BatchRenderer::FileResult& result)
+    {
+        if (result.error.isNotEmpty())
+            std::cerr << result.input.getFullPathName() << ": " << result.error << "\n";
+        else
+            std::cout << result.output.getFullPathName() << "  "
+                      << juce::String (result.audioSeconds / juce::jmax (1.0e-9, result.wallSeconds), 1) << "x realtime\n";
+    }
+
+    int printSummary (const BatchRenderer::Summary& summary)
+    {
+        std::cout << "\n" << summary.numFiles - summary.numFailed << " of " << summary.numFiles << " files rendered, "
+                  << juce::String (summary.audioSeconds, 1) << " s of audio in " << juce::String (summary.wallSeconds, 1) << " s, "
+                  << juce::String (summary.getRealtimeMultiple(), 1) << "x realtime\n";
+
+        return summary.numFailed == 0 ? 0 : 1;
+    }
+
+    int renderGraph (const juce::String& graphPath, const juce::File& outputDirectory, const juce::String& jobs,
+                     const juce::String& blockSize, const juce::String& sampleRate, const juce::String& tail,
+                     const juce::ArgumentList& args)
+    {
+        auto graphFile = juce::File::getCurrentWorkingDirectory().getChildFile (graphPath);
+
+        FilterGraph graph;
+        juce::StringArray warnings;
+        auto error = graph.load (graphFile, warnings);
+
+        for (auto& warning : warnings)
+            std::cerr << "Warning: " << warning << "\n";
+
+        if (error.isNotEmpty())
+        {
+            std::cerr << error << "\n";
+            return 1;
+        }
+
+        GraphRenderer::Options options;
+        options.outputDirectory = outputDirectory;
+
+        if (jobs.isNotEmpty())
+            options.numThreads = jobs.getIntValue();
+
+        if (blockSize.isNotEmpty())
+            options.blockSize = blockSize.getIntValue();
+
+        if (sampleRate.isNotEmpty())
+            options.sampleRate = sampleRate.getDoubleValue();
+
+        if (tail.isNotEmpty())
+            options.tailSeconds = tail.getDoubleValue();
+
+        GraphRenderer renderer (graph, std::move (options));
+        return printSummary (renderer.render (findInputFiles (args, "*.wav;*.aif;*.aiff;*.flac;*.mid;*.midi"), printResult));
+    }
+
+    int matchFile (const juce::String& referencePath, const juce::File& outputFile, const juce::String& jobs,
+                   const juce::String& bands, const juce::ArgumentList& args)
+    {
+        auto files = findInputFiles (args, "*.wav;*.aif;*.aiff;*.flac");
+
+        if (files.size() != 1)
+        {
+            std::cerr << "--match takes exactly one file to match to the reference\n";
+            return 1;
+        }
+
+        MatchAnalyser::Options options;
+
+        if (jobs.isNotEmpty())
+            options.numThreads = jobs.getIntValue();
+
+        if (bands.isNotEmpty())
+            options.numBands = bands.getIntValue();
+
+        auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        MatchAnalyser analyser (options);
+        auto result = analyser.analyse (juce::File::getCurrentWorkingDirectory().getChildFile (referencePath), files.getFirst().file);
+
+        if (result.error.isNotEmpty())
+        {
+            std::cerr << result.error << "\n";
+            return 1;
+        }
+
+        auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+        // Start from the plugin's defaults so that everything but the fitted bands stays as it would.
+        SimpleEQAudioProcessor processor;
+        auto settings = getChainSettings (processor.apvst);
+
+        for (auto i = (size_t) BandDesign::numFixedBands; i < settings.bands.size(); ++i)
+        {
+            auto& band = result.settings.bands[i];
+            settings.bands[i] = band;
+
+            if (band.type != BandType::Off)
+                std::cout << "Band " << (int) i + 1 << ": " << BandDesign::getTypeNames()[(int) band.type] << " at "
+                          << juce::String (band.frequency, 1) << " Hz, " << juce::String (band.gainInDecibels, 2) << " dB, Q "
+                          << juce::String (band.quality, 2) << "\n";
+        }
+
+        setChainSettings (processor.apvst, settings);
+
+        juce::MemoryBlock state;
+        processor.getStateInformation (state);
+
+        if (! outputFile.replaceWithData (state.getData(), state.getSize()))
+        {
+            std::cerr << "Couldn't write " << outputFile.getFullPathName() << "\n";
+            return 1;
+        }
+
+        std::cout << "\n" << juce::String (result.rmsErrorInDecibels, 2) << " dB RMS left over "
+                  << result.frequencies.size() << " points, analysed in " << juce::String (wallSeconds, 2) << " s\n"
+                  << outputFile.getFullPathName() << "\n";
+
+        return 0;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processors' parameter trees expect a message manager to exist, even
+    // though nothing here ever runs its loop.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args (argc, argv);
+
+    // Take the option values out so that only the input files are left.
+    auto presetPath = args.removeValueForOption ("--preset");
+    auto graphPath = args.removeValueForOption ("--graph");
+    auto referencePath = args.removeValueForOption ("--match");
+    auto outputPath = args.removeValueForOption ("--output");
+    auto jobs = args.removeValueForOption ("--jobs");
+    auto blockSize = args.removeValueForOption ("--block-size");
+    auto sampleRate = args.removeValueForOption ("--sample-rate");
+    auto tail = args.removeValueForOption ("--tail");
+    auto bands = args.removeValueForOption ("--bands");
+    auto benchmark = args.removeValueForOption ("--bench");
+
+    if (benchmark.isNotEmpty())
+    {
+        if (Benchmarks::run (benchmark))
+            return 0;
+
+        printUsage();
+        return 1;
+    }
+
+    auto numModes = (int) presetPath.isNotEmpty() + (int) graphPath.isNotEmpty() + (int) referencePath.isNotEmpty();
+
+    if (numModes != 1 || outputPath.isEmpty() || args.size() == 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    // A directory to render into, or with --match the state file to write.
+    auto output = juce::File::getCurrentWorkingDirectory().getChildFile (outputPath);
+
+    if (referencePath.isNotEmpty())
+        return matchFile (referencePath, output, jobs, bands, args);
+
+    if (graphPath.isNotEmpty())
+        return renderGraph (graphPath, output, jobs, blockSize, sampleRate, tail, args);
+
+    BatchRenderer::Options options;
+    options.outputDirectory = output;
+
+    if (jobs.isNotEmpty())
+        options.numWorkers = jobs.getIntValue();
+
+    if (blockSize.isNotEmpty())
+        options.blockSize = blockSize.getIntValue();
+
+    auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile (presetPath);
+
+    if (! loadPreset (presetFile, options.state))
+    {
+        std::cerr << "Couldn't load the preset " << presetFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    auto files = findInputFiles (args, "*.wav;*.aif;*.aiff;*.flac");
+    BatchRenderer renderer (std::move (options));
+
+    return printSummary (renderer.render (files, printResult));
+}
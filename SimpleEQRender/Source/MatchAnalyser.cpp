@@ -0,0 +1,442 @@
+/*
+  ==============================================================================
+
+    MatchAnalyser.cpp
+    Created: 18 Oct 2026 9:12:36am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#include "MatchAnalyser.h"
+#include "BatchRenderer.h"
+#include "../../SimpleEQ/Source/FilterResponse.h"
+
+namespace
+{
+    constexpr double lowestFrequency = 20.0, highestFrequency = 20000.0;
+    constexpr int pointsPerOctave = 24;
+    constexpr double smoothingOctaves = 1.0 / 3.0;
+    constexpr int framesPerChunk = 64;
+
+    /** The spectrum's power averaged over smoothingOctaves around each frequency, in dB. */
+    std::vector<double> smoothToGrid (const MatchAnalyser::Spectrum& spectrum, int fftSize, const std::vector<double>& frequencies)
+    {
+        std::vector<double> decibels;
+        decibels.reserve (frequencies.size());
+
+        auto binWidth = spectrum.sampleRate / fftSize;
+        auto lastBin = (int) spectrum.power.size() - 1;
+        auto halfWidth = std::exp2 (0.5 * smoothingOctaves);
+
+        for (auto frequency : frequencies)
+        {
+            auto first = (int) std::ceil (frequency / halfWidth / binWidth);
+            auto last = (int) std::floor (frequency * halfWidth / binWidth);
+
+            // Down where the band is narrower than a bin, take the nearest one.
+            if (last < first)
+                first = last = juce::roundToInt (frequency / binWidth);
+
+            first = juce::jlimit (0, lastBin, first);
+            last = juce::jlimit (first, lastBin, last);
+
+            auto sum = 0.0;
+
+            for (auto bin = first; bin <= last; ++bin)
+                sum += spectrum.power[(size_t) bin];
+
+            decibels.push_back (10.0 * std::log10 (sum / (last - first + 1) + 1.0e-20));
+        }
+
+        return decibels;
+    }
+
+    /** Evaluates candidate settings against the difference to be made up. */
+    struct FitTarget
+    {
+        const std::vector<double>& frequencies;
+        const std::vector<double>& difference;
+        double sampleRate;
+
+        std::vector<double> getResponseInDecibels (const ChainSettings& settings) const
+        {
+            std::vector<double> response (frequencies.size(), 1.0);
+            FilterResponse::applyChainMagnitudes (settings, sampleRate, frequencies.data(), response.data(), response.size());
+
+            for (auto& value : response)
+                value = juce::Decibels::gainToDecibels (value, -200.0);
+
+            return response;
+        }
+
+        /** The mean squared error in dB^2. */
+        double getError (const ChainSettings& settings) const
+        {
+            auto response = getResponseInDecibels (settings);
+            auto sum = 0.0;
+
+            for (size_t i = 0; i < response.size(); ++i)
+                sum += (difference[i] - response[i]) * (difference[i] - response[i]);
+
+            return sum / (double) response.size();
+        }
+    };
+
+    /** Keeps a band inside what the parameters allow, and shelves gentle enough
+        for the matched design.
+    */
+    void limitBand (BandSettings& band, double sampleRate)
+    {
+        band.frequency = (float) juce::jlimit (lowestFrequency, juce::jmin (highestFrequency, sampleRate * 0.45), (double) band.frequency);
+        band.gainInDecibels = juce::jlimit (-24.f, 24.f, band.gainInDecibels);
+
+        auto maxQuality = band.type == BandType::Bell ? 10.f : BandDesign::Matched::maxShelfQuality;
+        band.quality = juce::jlimit (0.1f, maxQuality, band.quality);
+    }
+}
+
+//==============================================================================
+class MatchAnalyser::SegmentJob  : public juce::ThreadPoolJob
+{
+public:
+    SegmentJob (juce::AudioFormat& formatToUse, const juce::File& fileToRead, int fftOrder,
+                juce::int64 firstFrameToRead, juce::int64 endFrameToRead)
+        : juce::ThreadPoolJob ("Match analysis"),
+          format (formatToUse), file (fileToRead), fft (fftOrder),
+          window ((size_t) fft.getSize(), juce::dsp::WindowingFunction<float>::hann, false),
+          firstFrame (firstFrameToRead), endFrame (endFrameToRead)
+    {
+        power.assign ((size_t) fft.getSize() / 2 + 1, 0.0);
+    }
+
+    JobStatus runJob() override
+    {
+        auto reader = BatchRenderer::createReader (format, file);
+
+        if (reader == nullptr)
+        {
+            failed = true;
+            return jobHasFinished;
+        }
+
+        auto fftSize = fft.getSize();
+        auto hop = fftSize / 2;
+        auto numChannels = (int) reader->numChannels;
+
+        juce::AudioBuffer<float> chunk (numChannels, (framesPerChunk - 1) * hop + fftSize);
+        std::vector<float> fftData ((size_t) fftSize * 2);
+
+        for (auto frame = firstFrame; frame < endFrame && ! shouldExit(); frame += framesPerChunk)
+        {
+            auto numFrames = (int) juce::jmin ((juce::int64) framesPerChunk, endFrame - frame);
+            reader->read (&chunk, 0, (numFrames - 1) * hop + fftSize, frame * hop, true, true);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < numFrames; ++i)
+                {
+                    std::copy_n (chunk.getReadPointer (channel, i * hop), fftSize, fftData.begin());
+                    window.multiplyWithWindowingTable (fftData.data(), (size_t) fftSize);
+                    fft.performRealOnlyForwardTransform (fftData.data(), true);
+
+                    for (size_t bin = 0; bin < power.size(); ++bin)
+                    {
+                        auto re = (double) fftData[bin * 2], im = (double) fftData[bin * 2 + 1];
+                        power[bin] += re * re + im * im;
+                    }
+                }
+            }
+        }
+
+        return jobHasFinished;
+    }
+
+    std::vector<double> power;
+    bool failed = false;
+
+private:
+    juce::AudioFormat& format;
+    juce::File file;
+    juce::dsp::FFT fft;
+    juce::dsp::WindowingFunction<float> window;
+    juce::int64 firstFrame, endFrame;
+};
+
+//==============================================================================
+MatchAnalyser::MatchAnalyser (Options o)
+    : options (o), pool (juce::jmax (1, o.numThreads))
+{
+    options.fftOrder = juce::jlimit (9, 16, options.fftOrder);
+    options.numBands = juce::jlimit (1, BandDesign::maxBands - BandDesign::numFixedBands, options.numBands);
+
+    formatManager.registerBasicFormats();
+}
+
+MatchAnalyser::~MatchAnalyser()
+{
+    pool.removeAllJobs (true, -1);
+}
+
+MatchAnalyser::Result MatchAnalyser::analyse (const juce::File& reference, const juce::File& target)
+{
+    Result result;
+    result.error = measureSpectra (reference, target, result);
+
+    if (result.error.isEmpty())
+        fitBands (result);
+
+    return result;
+}
+
+/** Runs both files through the pool at once, each cut into one run of frames
+    per thread, and averages the runs back together.
+*/
+juce::String MatchAnalyser::measureSpectra (const juce::File& reference, const juce::File& target, Result& result)
+{
+    auto fftSize = 1 << options.fftOrder;
+    auto hop = fftSize / 2;
+
+    struct FileJobs
+    {
+        Spectrum* spectrum;
+        std::vector<std::unique_ptr<SegmentJob>> jobs;
+    };
+
+    std::array<FileJobs, 2> files { { { &result.reference, {} }, { &result.target, {} } } };
+    std::array<juce::File, 2> paths { reference, target };
+    std::array<juce::AudioFormat*, 2> formats {};
+
+    // Both files are checked before any job is queued, so that nothing is left
+    // running on a file that is about to be given up on.
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        formats[i] = formatManager.findFormatForFileExtension (paths[i].getFileExtension());
+
+        if (formats[i] == nullptr)
+            return paths[i].getFileName() + ": unsupported file type";
+
+        auto reader = BatchRenderer::createReader (*formats[i], paths[i]);
+
+        if (reader == nullptr)
+            return paths[i].getFileName() + ": couldn't read the file";
+
+        // Whole frames only, except that a file shorter than one frame still gets one.
+        auto length = reader->lengthInSamples;
+        auto numFrames = length >= fftSize ? 1 + (length - fftSize) / hop : (length > 0 ? 1 : 0);
+
+        if (numFrames == 0)
+            return paths[i].getFileName() + ": the file is empty";
+
+        files[i].spectrum->sampleRate = reader->sampleRate;
+        files[i].spectrum->numFrames = numFrames;
+    }
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        auto numFrames = files[i].spectrum->numFrames;
+        auto numSegments = juce::jmin ((juce::int64) pool.getNumThreads(), numFrames);
+
+        for (juce::int64 segment = 0; segment < numSegments; ++segment)
+        {
+            files[i].jobs.push_back (std::make_unique<SegmentJob> (*formats[i], paths[i], options.fftOrder,
+                                                                   numFrames * segment / numSegments,
+                                                                   numFrames * (segment + 1) / numSegments));
+            pool.addJob (files[i].jobs.back().get(), false);
+        }
+    }
+
+    juce::String error;
+
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        auto& spectrum = *files[i].spectrum;
+        spectrum.power.assign ((size_t) fftSize / 2 + 1, 0.0);
+
+        for (auto& job : files[i].jobs)
+        {
+            pool.waitForJobToFinish (job.get(), -1);
+
+            if (job->failed)
+                error = paths[i].getFileName() + ": couldn't read the file";
+
+            for (size_t bin = 0; bin < spectrum.power.size(); ++bin)
+                spectrum.power[bin] += job->power[bin];
+        }
+
+        for (auto& value : spectrum.power)
+            value /= (double) spectrum.numFrames;
+    }
+
+    return error;
+}
+
+void MatchAnalyser::fitBands (Result& result) const
+{
+    auto fftSize = 1 << options.fftOrder;
+    auto sampleRate = result.target.sampleRate;
+    auto top = juce::jmin (highestFrequency, 0.45 * juce::jmin (result.reference.sampleRate, sampleRate));
+
+    result.frequencies.clear();
+
+    for (auto frequency = lowestFrequency; frequency <= top; frequency *= std::exp2 (1.0 / pointsPerOctave))
+        result.frequencies.push_back (frequency);
+
+    auto referenceLevels = smoothToGrid (result.reference, fftSize, result.frequencies);
+    auto targetLevels = smoothToGrid (result.target, fftSize, result.frequencies);
+
+    // Overall level is the fader's job rather than the EQ's, so take the mean out.
+    // Beyond the gain range, e.g. above a reference's band limit, only chase the range.
+    auto& difference = result.difference;
+    difference.resize (result.frequencies.size());
+
+    for (size_t i = 0; i < difference.size(); ++i)
+        difference[i] = referenceLevels[i] - targetLevels[i];
+
+    auto mean = std::accumulate (difference.begin(), difference.end(), 0.0) / (double) difference.size();
+
+    for (auto& value : difference)
+        value = juce::jlimit (-24.0, 24.0, value - mean);
+
+    FitTarget fitTarget { result.frequencies, difference, sampleRate };
+    auto& settings = result.settings;
+    settings = {};
+
+    auto error = fitTarget.getError (settings);
+
+    for (int fitted = 0; fitted < options.numBands; ++fitted)
+    {
+        auto bandIndex = (size_t) (BandDesign::numFixedBands + fitted);
+        auto response = fitTarget.getResponseInDecibels (settings);
+
+        std::vector<double> residual (difference.size());
+
+        for (size_t i = 0; i < residual.size(); ++i)
+            residual[i] = difference[i] - response[i];
+
+        std::vector<BandSettings> candidates;
+
+        // A bell as wide as the biggest remaining bump is at half its height.
+        {
+            auto peak = (size_t) std::distance (residual.begin(), std::max_element (residual.begin(), residual.end(),
+                                                                                   [] (double a, double b) { return std::abs (a) < std::abs (b); }));
+            auto halfHeight = 0.5 * residual[peak];
+            auto low = peak, high = peak;
+
+            while (low > 0 && std::abs (residual[low - 1]) > std::abs (halfHeight) && residual[low - 1] * halfHeight > 0.0)
+                --low;
+
+            while (high + 1 < residual.size() && std::abs (residual[high + 1]) > std::abs (halfHeight) && residual[high + 1] * halfHeight > 0.0)
+                ++high;
+
+            auto octaves = juce::jmax (2.0, (double) (high - low + 1)) / pointsPerOctave;
+            auto ratio = std::exp2 (octaves);
+
+            BandSettings bell;
+            bell.type = BandType::Bell;
+            bell.frequency = (float) result.frequencies[peak];
+            bell.gainInDecibels = (float) residual[peak];
+            bell.quality = (float) (std::sqrt (ratio) / (ratio - 1.0));
+            candidates.push_back (bell);
+        }
+
+        // Shelves at a few corners, each making up the mean error beyond its corner.
+        for (auto type : { BandType::LowShelf, BandType::HighShelf })
+        {
+            for (auto corner : type == BandType::LowShelf ? std::initializer_list<double> { 80.0, 160.0, 320.0 }
+                                                          : std::initializer_list<double> { 3000.0, 6000.0, 12000.0 })
+            {
+                auto sum = 0.0;
+                auto count = 0;
+
+                for (size_t i = 0; i < residual.size(); ++i)
+                {
+                    if ((type == BandType::LowShelf) == (result.frequencies[i] < corner))
+                    {
+                        sum += residual[i];
+                        ++count;
+                    }
+                }
+
+                if (count == 0)
+                    continue;
+
+                BandSettings shelf;
+                shelf.type = type;
+                shelf.frequency = (float) corner;
+                shelf.gainInDecibels = (float) (sum / count);
+                shelf.quality = 0.71f;
+                candidates.push_back (shelf);
+            }
+        }
+
+        auto bestError = error;
+        auto bestCandidate = -1;
+
+        for (size_t c = 0; c < candidates.size(); ++c)
+        {
+            candidates[c].engine = BandEngine::Matched;
+            limitBand (candidates[c], sampleRate);
+
+            auto trial = settings;
+            trial.bands[bandIndex] = candidates[c];
+
+            auto trialError = fitTarget.getError (trial);
+
+            if (trialError < bestError)
+            {
+                bestError = trialError;
+                bestCandidate = (int) c;
+            }
+        }
+
+        // Nothing left that a band can help with.
+        if (bestCandidate < 0)
+            break;
+
+        settings.bands[bandIndex] = candidates[(size_t) bestCandidate];
+        error = bestError;
+
+        // Then nudge every band so far, in frequency (octaves), gain (dB) and
+        // quality (octaves of Q), halving the steps whenever nothing helps.
+        for (auto step = 0.25; step > 0.01; step *= 0.5)
+        {
+            for (int sweep = 0; sweep < 8; ++sweep)
+            {
+                auto improved = false;
+
+                for (auto band = (size_t) BandDesign::numFixedBands; band <= bandIndex; ++band)
+                {
+                    for (int parameter = 0; parameter < 3; ++parameter)
+                    {
+                        for (auto direction : { 1.0, -1.0 })
+                        {
+                            auto trial = settings;
+                            auto& trialBand = trial.bands[band];
+
+                            if (parameter == 0)         trialBand.frequency *= (float) std::exp2 (direction * step);
+                            else if (parameter == 1)    trialBand.gainInDecibels += (float) (direction * step * 4.0);
+                            else                        trialBand.quality *= (float) std::exp2 (direction * step * 2.0);
+
+                            limitBand (trialBand, sampleRate);
+                            auto trialError = fitTarget.getError (trial);
+
+                            if (trialError < error)
+                            {
+                                settings = trial;
+                                error = trialError;
+                                improved = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                if (! improved)
+                    break;
+            }
+        }
+    }
+
+    result.rmsErrorInDecibels = std::sqrt (error);
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    MatchAnalyser.h
+    Created: 18 Oct 2026 9:12:36am
+    Author:  Tharindu Damruwan
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../SimpleEQ/Source/BandDesign.h"
+
+//==============================================================================
+/**
+    Works out the SimpleEQ settings that make a target file sound tonally like a
+    reference file.
+
+    Both files are cut into equal runs of frames, and each run goes to its own
+    job on a thread pool. Each job streams its run off disk in chunks of frames
+    through one FFT and window that it keeps for the whole run, and adds up the
+    power in every bin, so no file is ever decoded whole. The runs are then
+    summed into each file's long-term average spectrum.
+
+    The two spectra are smoothed to a third of an octave on a log-spaced grid,
+    and their difference, with the overall level taken out, is what the EQ has
+    to make up. Bands are added one at a time, each as whichever of a bell at
+    the biggest remaining error or a low or high shelf helps most, and after
+    each one every band so far is refined against the whole curve through
+    SimpleEQ's own response, so what is fitted is what will be heard.
+*/
+class MatchAnalyser
+{
+public:
+    struct Options
+    {
+        int numThreads = juce::SystemStats::getNumCpus();
+        int fftOrder = 13;
+        int numBands = 8;                   // at most maxBands - numFixedBands
+    };
+
+    struct Spectrum
+    {
+        std::vector<double> power;          // mean power of each bin, summed over channels
+        double sampleRate = 0.0;
+        juce::int64 numFrames = 0;
+    };
+
+    struct Result
+    {
+        juce::String error;                 // empty if the analysis worked
+        Spectrum reference, target;
+
+        std::vector<double> frequencies;    // the grid the fit ran on, in Hz
+        std::vector<double> difference;     // reference minus target there, in dB
+
+        ChainSettings settings;             // the fitted bands; the fixed ones are off
+        double rmsErrorInDecibels = 0.0;    // what the fit leaves of the difference
+    };
+
+    explicit MatchAnalyser (Options);
+    ~MatchAnalyser();
+
+    Result analyse (const juce::File& reference, const juce::File& target);
+
+private:
+    class SegmentJob;
+
+    juce::String measureSpectra (const juce::File& reference, const juce::File& target, Result&);
+    void fitBands (Result&) const;
+
+    Options options;
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatchAnalyser)
+};